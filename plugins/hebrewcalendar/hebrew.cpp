@@ -221,8 +221,49 @@ static QString monthName(int month, int year)
 Element::List Hebrew::createDayElements(const QDate &date)
 {
     Element::List el;
-    QString text;
+    el.append(new StoredElement(QStringLiteral("main element"), dayText(date)));
+    return el;
+}
+
+QString Hebrew::dayText(const QDate &date)
+{
+    if (!date.isValid()) {
+        return {};
+    }
+
+    for (qsizetype i = 0; i < yearCache.size(); ++i) {
+        const qint64 index = yearCache.at(i).firstDay.daysTo(date);
+        if (index >= 0 && index < yearCache.at(i).dayTexts.size()) {
+            // Keep the most recently used year last, the first one is evicted
+            yearCache.move(i, yearCache.size() - 1);
+            return yearCache.constLast().dayTexts.at(index);
+        }
+    }
+
+    // Day numbers start with 1 on 1 Tishrei
     const KHolidays::HebrewDate hd = KHolidays::HebrewDate::fromSecular(date.year(), date.month(), date.day());
+    HebrewYear year;
+    year.firstDay = date.addDays(1 - hd.hebrewDayNumber());
+    const int longestYear = 385; // days of the longest leap years
+    year.dayTexts.reserve(longestYear);
+    for (QDate day = year.firstDay; year.dayTexts.size() < longestYear; day = day.addDays(1)) {
+        const KHolidays::HebrewDate dayHd = KHolidays::HebrewDate::fromSecular(day.year(), day.month(), day.day());
+        if (dayHd.year() != hd.year()) {
+            break;
+        }
+        year.dayTexts.append(formatDay(dayHd));
+    }
+
+    if (yearCache.size() >= 3) {
+        yearCache.removeFirst();
+    }
+    yearCache.append(year);
+    return year.dayTexts.value(year.firstDay.daysTo(date));
+}
+
+QString Hebrew::formatDay(const KHolidays::HebrewDate &hd) const
+{
+    QString text;
     const QStringList holidays = Holiday::findHoliday(hd, areWeInIsrael, showParsha, showChol, showOmer);
     text = i18nc("1. day of the month 2. hebrew month", "%1 %2", stringFromInteger(hd.day()), monthName(hd.month(), hd.year()));
 
@@ -230,9 +271,7 @@ Element::List Hebrew::createDayElements(const QDate &date)
         text += QLatin1StringView("<br/>\n") + holiday;
     }
 
-    text = i18nc("Change the next two strings if emphasis is done differently in your language.", "<qt><p align=\"center\"><i>\n%1\n</i></p></qt>", text);
-    el.append(new StoredElement(QStringLiteral("main element"), text));
-    return el;
+    return i18nc("Change the next two strings if emphasis is done differently in your language.", "<qt><p align=\"center\"><i>\n%1\n</i></p></qt>", text);
 }
 
 QString Hebrew::info() const
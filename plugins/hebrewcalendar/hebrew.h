@@ -11,6 +11,15 @@
 
 #include <EventViews/CalendarDecoration>
 
+#include <QDate>
+#include <QList>
+#include <QStringList>
+
+namespace KHolidays
+{
+class HebrewDate;
+}
+
 using namespace EventViews::CalendarDecoration;
 
 class Hebrew : public Decoration
@@ -25,6 +34,27 @@ public:
     [[nodiscard]] QString info() const override;
 
 private:
+    /**
+      The texts of all days of one Hebrew year, starting with 1 Tishrei.
+      They only depend on the settings read in the constructor.
+    */
+    struct HebrewYear {
+        QDate firstDay;
+        QStringList dayTexts;
+    };
+
+    /**
+      Returns the text shown for @p date. The texts are computed for the
+      whole Hebrew year on the first request for one of its days.
+    */
+    [[nodiscard]] QString dayText(const QDate &date);
+
+    /** Computes the text shown for the day @p hd. */
+    [[nodiscard]] QString formatDay(const KHolidays::HebrewDate &hd) const;
+
     bool showParsha, showChol, showOmer;
     bool areWeInIsrael;
+
+    /** the most recently used years, the views rarely need more than two */
+    QList<HebrewYear> yearCache;
 };
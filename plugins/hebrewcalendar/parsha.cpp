@@ -20,8 +20,8 @@
 QString Parsha::findParshaName(int dayNumber, int kvia, bool isLeapYear, bool useIsraelSettings)
 {
     // The names of the Parshiot.
-    static QStringList parshiotNames = QStringList();
-    parshiotNames << i18nc(
+    // They are looked up once, as every Shabbat asks for one
+    static const QStringList parshiotNames = QStringList() << i18nc(
         "These are weekly readings and do not have translations. "
         "They may have different spellings in your language; "
         "otherwise, just translate the sound to your characters",
@@ -14,6 +14,7 @@
 #include "actionmanager.h"
 #include "akonadicollectionview.h"
 #include "calendaradaptor.h"
+#include "calendarimporter.h"
 #include "calendarinterfaceadaptor.h"
 #include "calendarview.h"
 #include "kocore.h"
@@ -38,9 +39,12 @@
 #include <Akonadi/History>
 #include <Akonadi/ICalImporter>
 
+#include <KCalendarCore/Event>
 #include <KCalendarCore/FileStorage>
 #include <KCalendarCore/ICalFormat>
+#include <KCalendarCore/Journal>
 #include <KCalendarCore/Person>
+#include <KCalendarCore/Todo>
 
 #include <KIO/FileCopyJob>
 #include <KIO/StatJob>
@@ -837,33 +841,56 @@ void ActionManager::slotNewJournal()
     mCalendarView->newJournal(selectedCollection());
 }
 
-void ActionManager::slotMergeFinished(bool success, int total)
+void ActionManager::slotMergeFinished(int imported, int skipped, const QStringList &errors)
 {
-    Q_ASSERT(sender());
-    mImportAction->setEnabled(true);
-    auto importer = qobject_cast<Akonadi::ICalImporter *>(sender());
+    --mRunningMerges;
+    mImportAction->setEnabled(mRunningMerges == 0 && !mNewResourceRunning);
 
-    if (success) {
-        mCalendarView->showMessage(i18ncp("@info", "1 incidence was imported successfully.", "%1 incidences were imported successfully.", total),
-                                   KMessageWidget::Information);
+    if (errors.isEmpty()) {
+        QString message = i18ncp("@info", "1 incidence was imported successfully.", "%1 incidences were imported successfully.", imported);
+        if (skipped > 0) {
+            message += u' ' + i18ncp("@info", "1 duplicate was skipped.", "%1 duplicates were skipped.", skipped);
+        }
+        mCalendarView->showMessage(message, KMessageWidget::Information);
     } else {
-        mCalendarView->showMessage(xi18nc("@info", "There was an error while merging the calendar: <message>%1</message>", importer->errorMessage()),
+        mCalendarView->showMessage(xi18nc("@info",
+                                          "There was an error while merging the calendar: <message>%1</message>",
+                                          errors.join(QStringLiteral("<nl/>"))),
                                    KMessageWidget::Error);
     }
-    sender()->deleteLater();
 }
 
 void ActionManager::slotNewResourceFinished(bool success)
 {
     Q_ASSERT(sender());
     auto importer = qobject_cast<Akonadi::ICalImporter *>(sender());
-    mImportAction->setEnabled(true);
     if (success) {
         mCalendarView->showMessage(i18nc("@info", "New calendar added successfully"), KMessageWidget::Information);
     } else {
         mCalendarView->showMessage(xi18nc("@info", "Could not add a calendar. Error: <message>%1</message>", importer->errorMessage()), KMessageWidget::Error);
     }
     sender()->deleteLater();
+    mNewResourceRunning = false;
+    startNextNewResource();
+}
+
+void ActionManager::startNextNewResource()
+{
+    while (!mNewResourceRunning && !mNewResourceQueue.isEmpty()) {
+        const QUrl url = mNewResourceQueue.takeFirst();
+        auto importer = new Akonadi::ICalImporter();
+        connect(importer, &Akonadi::ICalImporter::importIntoNewFinished, this, &ActionManager::slotNewResourceFinished);
+        mNewResourceRunning = importer->importIntoNewResource(url.path());
+        if (!mNewResourceRunning) {
+            // empty error message means user canceled.
+            if (!importer->errorMessage().isEmpty()) {
+                mCalendarView->showMessage(xi18nc("@info", "An error occurred: <message>%1 (url: %2)</message>", importer->errorMessage(), url.path()),
+                                           KMessageWidget::Error);
+            }
+            importer->deleteLater();
+        }
+    }
+    mImportAction->setEnabled(mRunningMerges == 0 && !mNewResourceRunning);
 }
 
 void ActionManager::readSettings()
@@ -980,27 +1007,40 @@ void ActionManager::file_archive()
 
 bool ActionManager::importURL(const QUrl &url, bool merge)
 {
-    auto importer = new Akonadi::ICalImporter();
-    bool jobStarted;
-    if (merge) {
-        connect(importer, &Akonadi::ICalImporter::importIntoExistingFinished, this, &ActionManager::slotMergeFinished);
-        jobStarted = importer->importIntoExistingResource(url, Akonadi::Collection());
-    } else {
-        connect(importer, &Akonadi::ICalImporter::importIntoNewFinished, this, &ActionManager::slotNewResourceFinished);
-        jobStarted = importer->importIntoNewResource(url.path());
+    return importURLs({url}, merge);
+}
+
+bool ActionManager::importURLs(const QList<QUrl> &urls, bool merge)
+{
+    if (urls.isEmpty()) {
+        return false;
     }
 
-    if (jobStarted) {
-        mImportAction->setEnabled(false);
-    } else {
-        // empty error message means user canceled.
-        if (!importer->errorMessage().isEmpty()) {
-            mCalendarView->showMessage(xi18nc("@info", "An error occurred: <message>%1 (url: %2)</message>", importer->errorMessage(), url.path()),
-                                       KMessageWidget::Error);
-        }
+    if (!merge) {
+        mNewResourceQueue.append(urls);
+        startNextNewResource();
+        return true;
+    }
+
+    int dialogCode = 0;
+    const QStringList mimeTypes = {KCalendarCore::Event::eventMimeType(), KCalendarCore::Todo::todoMimeType(), KCalendarCore::Journal::journalMimeType()};
+    const Akonadi::Collection collection = Akonadi::CalendarUtils::selectCollection(dialogParent(), dialogCode /*by-ref*/, mimeTypes);
+    if (!collection.isValid()) {
+        // canceled
+        return false;
     }
 
-    return jobStarted;
+    auto importer = new CalendarImporter(collection, this);
+    importer->setChunkSize(KOPrefs::instance()->importChunkSize());
+    importer->setMaximumFiles(KOPrefs::instance()->importParallelFiles());
+    for (const QUrl &url : urls) {
+        importer->addUrl(url);
+    }
+    connect(importer, &CalendarImporter::finished, this, &ActionManager::slotMergeFinished);
+    ++mRunningMerges;
+    mImportAction->setEnabled(false);
+    importer->start();
+    return true;
 }
 
 bool ActionManager::saveURL()
@@ -1234,14 +1274,15 @@ bool ActionManager::handleCommandLine(const QStringList &args)
 
         // Check for import, merge or ask
         const QStringList argList = parser.positionalArguments();
+        QList<QUrl> urls;
+        urls.reserve(argList.size());
+        for (const QString &argUrl : argList) {
+            urls.append(QUrl::fromUserInput(argUrl));
+        }
         if (parser.isSet(QStringLiteral("import"))) {
-            for (const QString &argUrl : argList) {
-                importURL(QUrl::fromUserInput(argUrl), /*merge=*/false);
-            }
+            importURLs(urls, /*merge=*/false);
         } else if (parser.isSet(QStringLiteral("merge"))) {
-            for (const QString &argUrl : argList) {
-                importURL(QUrl::fromUserInput(argUrl), /*merge=*/true);
-            }
+            importURLs(urls, /*merge=*/true);
         } else {
             for (const QString &argUrl : argList) {
                 mainWindow->actionManager()->importCalendar(QUrl::fromUserInput(argUrl));
@@ -80,6 +80,13 @@ public:
 public Q_SLOTS:
     bool importURL(const QUrl &url, bool merge);
 
+    /**
+      Imports @p urls. When merging, the destination calendar is asked for
+      once and the files are imported in chunks by a CalendarImporter.
+      Otherwise each file is added as a new calendar, one after the other.
+    */
+    bool importURLs(const QList<QUrl> &urls, bool merge);
+
     /** Save calendar file to URL of current calendar */
     [[nodiscard]] bool saveURL();
 
@@ -289,7 +296,7 @@ private Q_SLOTS:
     void slotNewSubTodo();
     void slotNewJournal();
 
-    void slotMergeFinished(bool success, int total);
+    void slotMergeFinished(int imported, int skipped, const QStringList &errors);
     void slotNewResourceFinished(bool);
 
 private:
@@ -302,6 +309,7 @@ private:
     KORGANIZERPRIVATE_NO_EXPORT Akonadi::ETMCalendar::Ptr calendar() const;
 
     KORGANIZERPRIVATE_NO_EXPORT Akonadi::Collection selectedCollection() const;
+    KORGANIZERPRIVATE_NO_EXPORT void startNextNewResource();
 
     QUrl mURL; // URL of calendar file
     QString mFile; // Local name of calendar file
@@ -322,6 +330,10 @@ private:
     KToggleAction *mShowMenuBarAction = nullptr;
 
     QAction *mImportAction = nullptr;
+    // files waiting to be added as new calendars
+    QList<QUrl> mNewResourceQueue;
+    bool mNewResourceRunning = false;
+    int mRunningMerges = 0;
 
     QAction *mNewEventAction = nullptr;
     QAction *mNewTodoAction = nullptr;
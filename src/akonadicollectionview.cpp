@@ -672,6 +672,10 @@ void AkonadiCollectionView::setCollectionSelectionProxyModel(KCheckableProxyMode
 
 void AkonadiCollectionView::selectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
 {
+    // Checking a folder checks all its sub-calendars, the views rebuild once for all of them
+    if (mCalendarView) {
+        mCalendarView->beginCalendarChanges();
+    }
     bool changed = false;
 
     const auto selectedIndexes = selected.indexes();
@@ -700,6 +704,9 @@ void AkonadiCollectionView::selectionChanged(const QItemSelection &selected, con
         }
     }
 
+    if (mCalendarView) {
+        mCalendarView->commitCalendarChanges();
+    }
     if (changed) {
         Q_EMIT resourcesChanged(true);
     }
@@ -0,0 +1,151 @@
+/*
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "calendarimportertest.h"
+
+#include "../calendarimporter.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+QTEST_GUILESS_MAIN(CalendarImporterTest)
+
+namespace
+{
+// The zone has a name unknown to the system, so it can only be resolved
+// from its VTIMEZONE component
+const char calendarText[] =
+    "BEGIN:VCALENDAR\r\n"
+    "PRODID:-//K Desktop Environment//NONSGML KOrganizer//EN\r\n"
+    "VERSION:2.0\r\n"
+    "BEGIN:VTIMEZONE\r\n"
+    "TZID:Custom Central European\r\n"
+    "BEGIN:STANDARD\r\n"
+    "DTSTART:19701025T030000\r\n"
+    "RRULE:FREQ=YEARLY;BYDAY=-1SU;BYMONTH=10\r\n"
+    "TZOFFSETFROM:+0200\r\n"
+    "TZOFFSETTO:+0100\r\n"
+    "END:STANDARD\r\n"
+    "BEGIN:DAYLIGHT\r\n"
+    "DTSTART:19700329T020000\r\n"
+    "RRULE:FREQ=YEARLY;BYDAY=-1SU;BYMONTH=3\r\n"
+    "TZOFFSETFROM:+0100\r\n"
+    "TZOFFSETTO:+0200\r\n"
+    "END:DAYLIGHT\r\n"
+    "END:VTIMEZONE\r\n"
+    "BEGIN:VEVENT\r\n"
+    "UID:event-1\r\n"
+    "DTSTAMP:20260101T000000Z\r\n"
+    "DTSTART;TZID=Custom Central European:20260302T100000\r\n"
+    "SUMMARY:First\r\n"
+    "BEGIN:VALARM\r\n"
+    "ACTION:DISPLAY\r\n"
+    "TRIGGER:-PT15M\r\n"
+    "DESCRIPTION:Reminder\r\n"
+    "END:VALARM\r\n"
+    "END:VEVENT\r\n"
+    "BEGIN:VTODO\r\n"
+    "UID:todo-1\r\n"
+    "DTSTAMP:20260101T000000Z\r\n"
+    "SUMMARY:Second\r\n"
+    "END:VTODO\r\n"
+    "BEGIN:VEVENT\r\n"
+    "UID:event-2\r\n"
+    "DTSTAMP:20260101T000000Z\r\n"
+    "DTSTART;TZID=Custom Central European:20260303T100000\r\n"
+    "SUMMARY:Third\r\n"
+    "END:VEVENT\r\n"
+    "END:VCALENDAR\r\n";
+
+QString writeFile(const QTemporaryDir &dir, const QByteArray &text)
+{
+    const QString fileName = dir.filePath(QStringLiteral("import.ics"));
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(text) != text.size()) {
+        return {};
+    }
+    return fileName;
+}
+
+QStringList summaries(const KCalendarCore::Incidence::List &incidences)
+{
+    QStringList result;
+    for (const KCalendarCore::Incidence::Ptr &incidence : incidences) {
+        result.append(incidence->summary());
+    }
+    result.sort();
+    return result;
+}
+}
+
+void CalendarImporterTest::testScanCalendarFile()
+{
+    QTemporaryDir dir;
+    const QString fileName = writeFile(dir, calendarText);
+    QVERIFY(!fileName.isEmpty());
+
+    const CalendarImport::ScanResult result = CalendarImport::scanCalendarFile(fileName);
+    QVERIFY(result.errorString.isEmpty());
+    QVERIFY(!result.vCalendar);
+
+    // The whole time zone with its nested components, and nothing else
+    QVERIFY(result.timeZones.startsWith("BEGIN:VTIMEZONE\r\nTZID:Custom Central European\r\n"));
+    QVERIFY(result.timeZones.endsWith("END:DAYLIGHT\r\nEND:VTIMEZONE\r\n"));
+    QVERIFY(result.timeZones.contains("END:STANDARD\r\n"));
+    QVERIFY(!result.timeZones.contains("VEVENT"));
+    QVERIFY(!result.timeZones.contains("VALARM"));
+
+    QVERIFY(!CalendarImport::scanCalendarFile(dir.filePath(QStringLiteral("missing.ics"))).errorString.isEmpty());
+}
+
+void CalendarImporterTest::testScanVCalendarFile()
+{
+    QTemporaryDir dir;
+    const QString fileName = writeFile(dir,
+                                       "BEGIN:VCALENDAR\r\n"
+                                       "VERSION:1.0\r\n"
+                                       "BEGIN:VEVENT\r\n"
+                                       "SUMMARY:Old\r\n"
+                                       "END:VEVENT\r\n"
+                                       "END:VCALENDAR\r\n");
+    QVERIFY(!fileName.isEmpty());
+    QVERIFY(CalendarImport::scanCalendarFile(fileName).vCalendar);
+}
+
+void CalendarImporterTest::testParseChunks()
+{
+    QTemporaryDir dir;
+    const QString fileName = writeFile(dir, calendarText);
+    QVERIFY(!fileName.isEmpty());
+    const QByteArray timeZones = CalendarImport::scanCalendarFile(fileName).timeZones;
+
+    // The time zone is not counted as a component, the alarm is part of its event
+    const CalendarImport::ChunkResult first = CalendarImport::parseChunk(fileName, 0, 1, timeZones);
+    QVERIFY(first.errorString.isEmpty());
+    QVERIFY(!first.atEnd);
+    QCOMPARE(summaries(first.incidences), QStringList({QStringLiteral("First")}));
+    QCOMPARE(first.incidences.constFirst()->alarms().size(), 1);
+    QVERIFY(QByteArrayView(calendarText).sliced(first.offset).startsWith("BEGIN:VTODO\r\n"));
+
+    // The next chunk starts where the first one ended, and still knows the time zone
+    const CalendarImport::ChunkResult second = CalendarImport::parseChunk(fileName, first.offset, 2, timeZones);
+    QVERIFY(second.errorString.isEmpty());
+    QCOMPARE(summaries(second.incidences), QStringList({QStringLiteral("Second"), QStringLiteral("Third")}));
+    for (const KCalendarCore::Incidence::Ptr &incidence : second.incidences) {
+        if (incidence->summary() == QLatin1StringView("Third")) {
+            QCOMPARE(incidence->dtStart().toUTC(), QDateTime(QDate(2026, 3, 3), QTime(9, 0), QTimeZone::UTC));
+        }
+    }
+
+    // Only the end of the calendar is left
+    const CalendarImport::ChunkResult last = CalendarImport::parseChunk(fileName, second.offset, 2, timeZones);
+    QVERIFY(last.errorString.isEmpty());
+    QVERIFY(last.atEnd);
+    QVERIFY(last.incidences.isEmpty());
+}
+
+#include "moc_calendarimportertest.cpp"
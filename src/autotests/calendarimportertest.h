@@ -0,0 +1,18 @@
+/*
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class CalendarImporterTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testScanCalendarFile();
+    void testScanVCalendarFile();
+    void testParseChunks();
+};
@@ -0,0 +1,159 @@
+/*
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "icalexportertest.h"
+
+#include "../icalexporter.h"
+
+#include <KCalendarCore/Event>
+#include <KCalendarCore/ICalFormat>
+#include <KCalendarCore/Journal>
+#include <KCalendarCore/MemoryCalendar>
+#include <KCalendarCore/Todo>
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+QTEST_GUILESS_MAIN(ICalExporterTest)
+
+namespace
+{
+// The lines of each component, sorted; the order of the components and the
+// time stamps of the serialization may differ
+QStringList components(const QByteArray &ical)
+{
+    QStringList result;
+    QString calendar;
+    QString current;
+    int depth = 0;
+    const QList<QByteArray> lines = ical.split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith("DTSTAMP")) {
+            continue;
+        }
+        if (line.startsWith("BEGIN:")) {
+            ++depth;
+        }
+        (depth > 1 ? current : calendar) += QString::fromUtf8(line) + u'\n';
+        if (line.startsWith("END:")) {
+            --depth;
+            if (depth == 1) {
+                result.append(current);
+                current.clear();
+            }
+        }
+    }
+    result.sort();
+    result.prepend(calendar);
+    return result;
+}
+
+// The TZIDs of the VTIMEZONE components, in the order they are written
+QList<QByteArray> timeZoneIds(const QByteArray &ical)
+{
+    QList<QByteArray> result;
+    bool inTimeZone = false;
+    const QList<QByteArray> lines = ical.split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith("BEGIN:VTIMEZONE")) {
+            inTimeZone = true;
+        } else if (line.startsWith("END:VTIMEZONE")) {
+            inTimeZone = false;
+        } else if (inTimeZone && line.startsWith("TZID:")) {
+            result.append(line.sliced(5).trimmed());
+        }
+    }
+    return result;
+}
+
+QByteArray exported(const KCalendarCore::Calendar::Ptr &calendar)
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("export.ics"));
+    ICalExporter exporter(calendar, fileName);
+    QSignalSpy finishedSpy(&exporter, &ICalExporter::finished);
+    exporter.start();
+    if (finishedSpy.isEmpty() && !finishedSpy.wait(10000)) {
+        return {};
+    }
+    if (!finishedSpy.constFirst().constFirst().toBool()) {
+        return {};
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return file.readAll();
+}
+}
+
+void ICalExporterTest::testSameContentAsICalFormat()
+{
+    KCalendarCore::MemoryCalendar::Ptr calendar(new KCalendarCore::MemoryCalendar(QTimeZone::UTC));
+    const QTimeZone berlin("Europe/Berlin");
+    const QTimeZone newYork("America/New_York");
+
+    // Enough incidences for several chunks
+    for (int i = 0; i < 3 * ICalExporter::chunkSize + 7; ++i) {
+        KCalendarCore::Event::Ptr event(new KCalendarCore::Event);
+        const QDate date = QDate(2020, 1, 1).addDays(i);
+        event->setSummary(QStringLiteral("Event %1").arg(i));
+        event->setDtStart(QDateTime(date, QTime(9, 0), i % 2 ? berlin : newYork));
+        event->setDtEnd(QDateTime(date, QTime(10, 0), i % 3 ? berlin : QTimeZone(QTimeZone::UTC)));
+        if (i % 10 == 0) {
+            event->recurrence()->setWeekly(1);
+        }
+        calendar->addEvent(event);
+    }
+    KCalendarCore::Todo::Ptr todo(new KCalendarCore::Todo);
+    todo->setSummary(QStringLiteral("A to-do"));
+    todo->setDtDue(QDateTime(QDate(2019, 6, 1), QTime(12, 0), newYork));
+    calendar->addTodo(todo);
+    KCalendarCore::Journal::Ptr journal(new KCalendarCore::Journal);
+    journal->setSummary(QStringLiteral("A journal"));
+    journal->setDtStart(QDateTime(QDate(2021, 3, 1), QTime(8, 0), berlin));
+    calendar->addJournal(journal);
+
+    const QByteArray streamed = exported(calendar);
+    QVERIFY(!streamed.isEmpty());
+    QVERIFY(streamed.startsWith("BEGIN:VCALENDAR"));
+    QVERIFY(streamed.endsWith("END:VCALENDAR\r\n"));
+
+    KCalendarCore::ICalFormat format;
+    QCOMPARE(components(streamed), components(format.toString(calendar).toUtf8()));
+}
+
+void ICalExporterTest::testTimeZoneOrder()
+{
+    KCalendarCore::MemoryCalendar::Ptr calendar(new KCalendarCore::MemoryCalendar(QTimeZone::UTC));
+    const QList<QTimeZone> zones = {QTimeZone("Asia/Tokyo"), QTimeZone("Europe/Berlin"), QTimeZone("America/New_York"), QTimeZone("Australia/Sydney")};
+    for (int i = 0; i < 2 * ICalExporter::chunkSize; ++i) {
+        KCalendarCore::Event::Ptr event(new KCalendarCore::Event);
+        const QDate date = QDate(2020, 1, 1).addDays(i);
+        event->setSummary(QStringLiteral("Event %1").arg(i));
+        event->setDtStart(QDateTime(date, QTime(9, 0), zones.at(i % zones.size())));
+        event->setDtEnd(QDateTime(date, QTime(10, 0), zones.at((i + 1) % zones.size())));
+        calendar->addEvent(event);
+    }
+
+    // Each export writes the zones in the same order as ICalFormat
+    KCalendarCore::ICalFormat format;
+    const QList<QByteArray> expected = timeZoneIds(format.toString(calendar).toUtf8());
+    QCOMPARE(expected.size(), zones.size());
+    QCOMPARE(timeZoneIds(exported(calendar)), expected);
+    QCOMPARE(timeZoneIds(exported(calendar)), expected);
+}
+
+void ICalExporterTest::testEmptyCalendar()
+{
+    KCalendarCore::MemoryCalendar::Ptr calendar(new KCalendarCore::MemoryCalendar(QTimeZone::UTC));
+    KCalendarCore::ICalFormat format;
+    QCOMPARE(components(exported(calendar)), components(format.toString(calendar).toUtf8()));
+}
+
+#include "moc_icalexportertest.cpp"
@@ -0,0 +1,68 @@
+/*
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "koglobalstest.h"
+
+#include "../koglobals.h"
+
+#include <KHolidays/HolidayRegion>
+
+#include <QStandardPaths>
+#include <QTest>
+
+QTEST_MAIN(KOGlobalsTest)
+
+void KOGlobalsTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void KOGlobalsTest::testHolidaysAcrossYearBoundary_data()
+{
+    QTest::addColumn<QString>("region");
+    QTest::addColumn<QDate>("start");
+    QTest::addColumn<QDate>("end");
+
+    // January 1, 2022 is a Saturday, so the holiday is observed in the year before
+    QTest::newRow("us, around new year") << QStringLiteral("us_en-us") << QDate(2021, 12, 24) << QDate(2022, 1, 7);
+    QTest::newRow("us, last day of the year") << QStringLiteral("us_en-us") << QDate(2021, 12, 31) << QDate(2021, 12, 31);
+    QTest::newRow("us, first days of the year") << QStringLiteral("us_en-us") << QDate(2022, 1, 1) << QDate(2022, 1, 3);
+    // Christmas and Boxing Day 2021 fall on a weekend and are observed later
+    QTest::newRow("gb, around new year") << QStringLiteral("gb-eng_en-gb") << QDate(2021, 12, 20) << QDate(2022, 1, 10);
+    QTest::newRow("gb, several years") << QStringLiteral("gb-eng_en-gb") << QDate(2020, 12, 1) << QDate(2023, 1, 31);
+}
+
+void KOGlobalsTest::testHolidaysAcrossYearBoundary()
+{
+    QFETCH(QString, region);
+    QFETCH(QDate, start);
+    QFETCH(QDate, end);
+
+    KOGlobals::self()->setHolidays({region});
+    if (KOGlobals::self()->holidays().isEmpty()) {
+        QSKIP("The holiday region is not installed");
+    }
+    const QMap<QDate, QStringList> cached = KOGlobals::self()->holiday(start, end);
+
+    // The holidays the region reports for the range itself
+    KHolidays::HolidayRegion direct(region);
+    direct.setCategories(KOGlobals::self()->holidayCategories());
+    QMap<QDate, QStringList> expected;
+    const KHolidays::Holiday::List holidays = direct.rawHolidaysWithAstroSeasons(start, end);
+    for (const KHolidays::Holiday &holiday : holidays) {
+        QStringList &names = expected[holiday.observedStartDate()];
+        if (!names.contains(holiday.name())) {
+            names.append(holiday.name());
+        }
+    }
+
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(cached, expected);
+    // Again, from the cache
+    QCOMPARE(KOGlobals::self()->holiday(start, end), expected);
+}
+
+#include "moc_koglobalstest.cpp"
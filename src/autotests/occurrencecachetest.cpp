@@ -0,0 +1,71 @@
+/*
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "occurrencecachetest.h"
+
+#include "../occurrencecache.h"
+
+#include <KCalendarCore/Event>
+#include <KCalendarCore/MemoryCalendar>
+
+#include <QTest>
+
+QTEST_GUILESS_MAIN(OccurrenceCacheTest)
+
+namespace
+{
+KCalendarCore::Event::Ptr createDailyEvent(QDate start)
+{
+    KCalendarCore::Event::Ptr event(new KCalendarCore::Event);
+    event->setDtStart(QDateTime(start, QTime(9, 0), QTimeZone::UTC));
+    event->setDtEnd(QDateTime(start, QTime(10, 0), QTimeZone::UTC));
+    event->recurrence()->setDaily(1);
+    return event;
+}
+}
+
+void OccurrenceCacheTest::testTimesInInterval()
+{
+    const auto event = createDailyEvent(QDate(2026, 1, 1));
+    const QDateTime start(QDate(2026, 1, 10), QTime(0, 0), QTimeZone::UTC);
+    const QDateTime end(QDate(2026, 1, 16), QTime(23, 59), QTimeZone::UTC);
+
+    OccurrenceCache cache;
+    const auto expected = event->recurrence()->timesInInterval(start, end);
+    QCOMPARE(expected.size(), 7);
+    QCOMPARE(cache.timesInInterval(event, start, end), expected);
+    QCOMPARE(cache.timesInInterval(event, start, end), expected);
+
+    // Each window is expanded on its own
+    const QDateTime otherEnd = end.addDays(7);
+    QCOMPARE(cache.timesInInterval(event, start, otherEnd), event->recurrence()->timesInInterval(start, otherEnd));
+    QCOMPARE(cache.timesInInterval(event, start, end), expected);
+}
+
+void OccurrenceCacheTest::testInvalidation()
+{
+    KCalendarCore::MemoryCalendar::Ptr calendar(new KCalendarCore::MemoryCalendar(QTimeZone::UTC));
+    OccurrenceCache cache;
+    calendar->registerObserver(&cache);
+
+    const auto event = createDailyEvent(QDate(2026, 1, 1));
+    calendar->addEvent(event);
+    const QDateTime start(QDate(2026, 1, 1), QTime(0, 0), QTimeZone::UTC);
+    const QDateTime end(QDate(2026, 1, 31), QTime(23, 59), QTimeZone::UTC);
+    QCOMPARE(cache.timesInInterval(event, start, end).size(), 31);
+
+    // Changes reported by the calendar drop the old expansions
+    event->recurrence()->setWeekly(1);
+    QCOMPARE(cache.timesInInterval(event, start, end).size(), 5);
+
+    event->recurrence()->setDaily(2);
+    cache.invalidate(event);
+    QCOMPARE(cache.timesInInterval(event, start, end).size(), 16);
+
+    calendar->unregisterObserver(&cache);
+}
+
+#include "moc_occurrencecachetest.cpp"
@@ -0,0 +1,17 @@
+/*
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class OccurrenceCacheTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testTimesInInterval();
+    void testInvalidation();
+};
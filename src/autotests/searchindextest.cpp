@@ -0,0 +1,120 @@
+/*
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "searchindextest.h"
+
+#include "../dialog/searchindex.h"
+
+#include <KCalendarCore/Event>
+
+#include <QTemporaryDir>
+#include <QTest>
+
+QTEST_GUILESS_MAIN(SearchIndexTest)
+
+namespace
+{
+KCalendarCore::Incidence::Ptr createEvent(const QString &summary, const QString &location = QString())
+{
+    KCalendarCore::Event::Ptr event(new KCalendarCore::Event);
+    event->setSummary(summary);
+    event->setLocation(location);
+    return event;
+}
+}
+
+void SearchIndexTest::testCandidates()
+{
+    QTemporaryDir dir;
+    SearchIndex index(dir.filePath(QStringLiteral("searchindex")));
+    index.updateItem(1, 1, createEvent(QStringLiteral("Weekly team meeting"), QStringLiteral("Room 42")));
+    index.updateItem(2, 1, createEvent(QStringLiteral("Dentist")));
+    index.updateItem(3, 1, createEvent(QStringLiteral("Steam engine museum")));
+
+    // Words of the pattern may be part of longer words
+    QCOMPARE(index.candidates(QStringLiteral("meet"), SearchEngine::Summary), QSet<Akonadi::Item::Id>({1}));
+    QCOMPARE(index.candidates(QStringLiteral("*TEAM*"), SearchEngine::Summary), QSet<Akonadi::Item::Id>({1, 3}));
+    QCOMPARE(index.candidates(QStringLiteral("team meet"), SearchEngine::Summary), QSet<Akonadi::Item::Id>({1}));
+
+    // Only the requested fields are looked at
+    QCOMPARE(index.candidates(QStringLiteral("room"), SearchEngine::Summary), QSet<Akonadi::Item::Id>());
+    QCOMPARE(index.candidates(QStringLiteral("room"), SearchEngine::Summary | SearchEngine::Location), QSet<Akonadi::Item::Id>({1}));
+
+    QCOMPARE(index.candidates(QStringLiteral("holiday"), SearchEngine::Summary), QSet<Akonadi::Item::Id>());
+
+    // "ananas" contains all trigrams of "nanana", but not the word
+    index.updateItem(4, 1, createEvent(QStringLiteral("Ananas")));
+    QCOMPARE(index.candidates(QStringLiteral("nana"), SearchEngine::Summary), QSet<Akonadi::Item::Id>({4}));
+    QCOMPARE(index.candidates(QStringLiteral("nanana"), SearchEngine::Summary), QSet<Akonadi::Item::Id>());
+
+    // Patterns without words can't use the index
+    QVERIFY(!index.candidates(QStringLiteral("*"), SearchEngine::Summary));
+    QVERIFY(!index.candidates(QStringLiteral("a?"), SearchEngine::Summary));
+    QVERIFY(!index.candidates(QStringLiteral("42"), SearchEngine::Location));
+
+    // Neither can patterns with character classes
+    QVERIFY(!index.candidates(QStringLiteral("[dw]entist"), SearchEngine::Summary));
+    QVERIFY(!index.candidates(QStringLiteral("team\\*"), SearchEngine::Summary));
+}
+
+void SearchIndexTest::testUpdateAndRemove()
+{
+    QTemporaryDir dir;
+    SearchIndex index(dir.filePath(QStringLiteral("searchindex")));
+    index.updateItem(1, 1, createEvent(QStringLiteral("Dentist")));
+    QVERIFY(index.isCurrent(1, 1));
+    QVERIFY(!index.isCurrent(1, 2));
+
+    // Indexed revisions are not indexed again
+    index.updateItem(1, 1, createEvent(QStringLiteral("Doctor")));
+    QCOMPARE(index.candidates(QStringLiteral("dentist"), SearchEngine::Summary), QSet<Akonadi::Item::Id>({1}));
+
+    index.updateItem(1, 2, createEvent(QStringLiteral("Doctor")));
+    QCOMPARE(index.candidates(QStringLiteral("dentist"), SearchEngine::Summary), QSet<Akonadi::Item::Id>());
+    QCOMPARE(index.candidates(QStringLiteral("doctor"), SearchEngine::Summary), QSet<Akonadi::Item::Id>({1}));
+
+    index.removeItem(1);
+    QVERIFY(!index.isCurrent(1, 2));
+    QCOMPARE(index.candidates(QStringLiteral("doctor"), SearchEngine::Summary), QSet<Akonadi::Item::Id>());
+}
+
+void SearchIndexTest::testRemoveMissingItems()
+{
+    QTemporaryDir dir;
+    SearchIndex index(dir.filePath(QStringLiteral("searchindex")));
+    index.updateItem(1, 1, createEvent(QStringLiteral("Dentist")), 10);
+    index.updateItem(2, 1, createEvent(QStringLiteral("Dentist")), 10);
+    index.updateItem(3, 1, createEvent(QStringLiteral("Dentist")), 20);
+
+    // Only the items of the given collection are removed
+    index.removeMissingItems(10, {2});
+    QCOMPARE(index.candidates(QStringLiteral("dentist"), SearchEngine::Summary), QSet<Akonadi::Item::Id>({2, 3}));
+}
+
+void SearchIndexTest::testPersistence()
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath(QStringLiteral("searchindex"));
+    {
+        SearchIndex index(fileName);
+        index.updateItem(1, 3, createEvent(QStringLiteral("Dentist")), 10);
+        index.updateItem(2, 5, createEvent(QStringLiteral("Doctor")));
+        index.removeItem(2);
+        QVERIFY(index.save());
+    }
+
+    SearchIndex index(fileName);
+    QVERIFY(index.isCurrent(1, 3));
+    QVERIFY(!index.isCurrent(2, 5));
+    QCOMPARE(index.candidates(QStringLiteral("dentist"), SearchEngine::Summary), QSet<Akonadi::Item::Id>({1}));
+    QCOMPARE(index.candidates(QStringLiteral("doctor"), SearchEngine::Summary), QSet<Akonadi::Item::Id>());
+
+    // The collection of the items is stored as well
+    index.removeMissingItems(10, {});
+    QVERIFY(!index.isCurrent(1, 3));
+}
+
+#include "moc_searchindextest.cpp"
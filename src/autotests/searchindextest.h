@@ -0,0 +1,19 @@
+/*
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QObject>
+
+class SearchIndexTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testCandidates();
+    void testUpdateAndRemove();
+    void testRemoveMissingItems();
+    void testPersistence();
+};
@@ -7,8 +7,11 @@
 */
 #include "testkodaymatrix.h"
 
+#include "../dayoccupancy.h"
 #include "../kodaymatrix.h"
 
+#include <KCalendarCore/Event>
+
 #include <QTest>
 QTEST_MAIN(KODayMatrixTest)
 
@@ -31,4 +34,63 @@ void KODayMatrixTest::testMatrixLimits()
     }
 }
 
+void KODayMatrixTest::testIncrementalOccupancy()
+{
+    QLocale::setDefault(QLocale(QStringLiteral("de_DE"))); // week start on Monday
+    DayOccupancy occupancy;
+    occupancy.setHighlightMode(true, false, false);
+    KODayMatrix matrix(nullptr);
+    matrix.setDayOccupancy(&occupancy);
+    matrix.updateView(QDate(2010, 12, 27));
+    QVERIFY(!matrix.dayHasIncidences(0));
+
+    KCalendarCore::Event::Ptr event(new KCalendarCore::Event);
+    event->setDtStart(QDateTime(QDate(2010, 12, 29), QTime(10, 0), QTimeZone::LocalTime));
+    event->setDtEnd(QDateTime(QDate(2010, 12, 30), QTime(11, 0), QTimeZone::LocalTime));
+    occupancy.calendarIncidenceAdded(event);
+    QVERIFY(!matrix.dayHasIncidences(1));
+    QVERIFY(matrix.dayHasIncidences(2));
+    QVERIFY(matrix.dayHasIncidences(3));
+    QVERIFY(!matrix.dayHasIncidences(4));
+
+    // A second incidence on the same day keeps it highlighted when the first one goes away
+    KCalendarCore::Event::Ptr other(new KCalendarCore::Event);
+    other->setDtStart(QDateTime(QDate(2010, 12, 30), QTime(8, 0), QTimeZone::LocalTime));
+    other->setDtEnd(QDateTime(QDate(2010, 12, 30), QTime(9, 0), QTimeZone::LocalTime));
+    occupancy.calendarIncidenceAdded(other);
+
+    event->setDtStart(QDateTime(QDate(2011, 1, 5), QTime(10, 0), QTimeZone::LocalTime));
+    event->setDtEnd(QDateTime(QDate(2011, 1, 5), QTime(11, 0), QTimeZone::LocalTime));
+    occupancy.calendarIncidenceChanged(event);
+    QVERIFY(!matrix.dayHasIncidences(2));
+    QVERIFY(matrix.dayHasIncidences(3));
+    QVERIFY(matrix.dayHasIncidences(9));
+
+    occupancy.calendarIncidenceDeleted(other, nullptr);
+    QVERIFY(!matrix.dayHasIncidences(3));
+    QVERIFY(matrix.dayHasIncidences(9));
+
+    // A second matrix showing the next month shares the occupancy
+    KODayMatrix nextMonth(nullptr);
+    nextMonth.setDayOccupancy(&occupancy);
+    nextMonth.updateView(QDate(2011, 1, 31));
+    QVERIFY(!nextMonth.dayHasIncidences(2));
+    other->setDtStart(QDateTime(QDate(2011, 2, 2), QTime(8, 0), QTimeZone::LocalTime));
+    other->setDtEnd(QDateTime(QDate(2011, 2, 2), QTime(9, 0), QTimeZone::LocalTime));
+    occupancy.calendarIncidenceAdded(other);
+    QVERIFY(nextMonth.dayHasIncidences(2));
+    QVERIFY(matrix.dayHasIncidences(37));
+    occupancy.calendarIncidenceDeleted(other, nullptr);
+    QVERIFY(!nextMonth.dayHasIncidences(2));
+    QVERIFY(!matrix.dayHasIncidences(37));
+
+    // Events outside of the visible range don't contribute anything
+    event->setDtStart(QDateTime(QDate(2012, 1, 5), QTime(10, 0), QTimeZone::LocalTime));
+    event->setDtEnd(QDateTime(QDate(2012, 1, 5), QTime(11, 0), QTimeZone::LocalTime));
+    occupancy.calendarIncidenceChanged(event);
+    for (int i = 0; i < 42; ++i) {
+        QVERIFY(!matrix.dayHasIncidences(i));
+    }
+}
+
 #include "moc_testkodaymatrix.cpp"
@@ -15,4 +15,5 @@ class KODayMatrixTest : public QObject
     Q_OBJECT
 private Q_SLOTS:
     void testMatrixLimits();
+    void testIncrementalOccupancy();
 };
@@ -0,0 +1,379 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "batchmode.h"
+#include "aboutdata.h"
+#include "calendarimporter.h"
+#include "calendarview.h"
+#include "dialog/searchengine.h"
+#include "icalexporter.h"
+#include "korganizer_debug.h"
+#include "korganizer_options.h"
+#include "prefs/koprefs.h"
+
+#include <Akonadi/CalendarUtils>
+#include <Akonadi/CollectionFetchJob>
+#include <Akonadi/CollectionFetchScope>
+#include <Akonadi/ItemFetchJob>
+#include <Akonadi/ItemFetchScope>
+
+#include <KCalendarCore/Event>
+#include <KCalendarCore/Journal>
+#include <KCalendarCore/Todo>
+
+#include <KConfig>
+#include <KLocalizedString>
+#include <KSharedConfig>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// Used for a range open on one side
+constexpr QDate earliestDate(1900, 1, 1);
+constexpr QDate latestDate(9999, 12, 31);
+
+QStringList incidenceMimeTypes()
+{
+    return {KCalendarCore::Event::eventMimeType(), KCalendarCore::Todo::todoMimeType(), KCalendarCore::Journal::journalMimeType()};
+}
+
+void printError(const QString &message)
+{
+    QTextStream(stderr) << message << '\n';
+}
+
+// Only known in batch mode, the interactive instances reject them
+void batchOptions(QCommandLineParser *parser)
+{
+    parser->addOption(QCommandLineOption(QStringLiteral("batch"),
+                                         i18nc("@info:shell",
+                                               "Run without user interface: export with --export, merge the specified files with "
+                                               "--merge or search with --search, then exit")));
+    parser->addOption(QCommandLineOption(QStringLiteral("export"),
+                                         i18nc("@info:shell", "In batch mode, export the calendars to the specified iCalendar file"),
+                                         i18nc("@info:shell", "File")));
+    parser->addOption(QCommandLineOption(QStringLiteral("search"),
+                                         i18nc("@info:shell", "In batch mode, print the incidences matching the specified regular expression"),
+                                         i18nc("@info:shell", "Expression")));
+    parser->addOption(QCommandLineOption(QStringLiteral("from"),
+                                         i18nc("@info:shell", "In batch mode, only use incidences on or after the specified date (YYYY-MM-DD)"),
+                                         i18nc("@info:shell", "Date")));
+    parser->addOption(QCommandLineOption(QStringLiteral("to"),
+                                         i18nc("@info:shell", "In batch mode, only use incidences on or before the specified date (YYYY-MM-DD)"),
+                                         i18nc("@info:shell", "Date")));
+    parser->addOption(QCommandLineOption(QStringLiteral("collection"),
+                                         i18nc("@info:shell",
+                                               "In batch mode, only use the calendar with the specified id; may be repeated. "
+                                               "Required when merging"),
+                                         i18nc("@info:shell", "Id")));
+    parser->addOption(QCommandLineOption(QStringLiteral("filter"),
+                                         i18nc("@info:shell", "In batch mode, apply the KOrganizer filter with the specified name"),
+                                         i18nc("@info:shell", "Name")));
+}
+}
+
+bool BatchMode::isRequested(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int BatchMode::run(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    KLocalizedString::setApplicationDomain(QByteArrayLiteral("korganizer"));
+
+    KOrg::AboutData aboutData;
+    KAboutData::setApplicationData(aboutData);
+
+    QCommandLineParser parser;
+    aboutData.setupCommandLine(&parser);
+    korganizer_options(&parser);
+    batchOptions(&parser);
+    parser.process(app);
+    aboutData.processCommandLine(&parser);
+
+    BatchMode batch;
+    if (!batch.parseArguments(parser)) {
+        return 1;
+    }
+    QTimer::singleShot(0, &batch, &BatchMode::start);
+    return app.exec();
+}
+
+BatchMode::BatchMode() = default;
+
+BatchMode::~BatchMode() = default;
+
+bool BatchMode::parseArguments(const QCommandLineParser &parser)
+{
+    const int actions = int(parser.isSet(QStringLiteral("export"))) + int(parser.isSet(QStringLiteral("merge")))
+        + int(parser.isSet(QStringLiteral("search")));
+    if (actions != 1) {
+        printError(i18nc("@info:shell", "Batch mode needs exactly one of --export, --merge and --search."));
+        return false;
+    }
+
+    const QStringList collections = parser.values(QStringLiteral("collection"));
+    for (const QString &collection : collections) {
+        bool ok = false;
+        const Akonadi::Collection::Id id = collection.toLongLong(&ok);
+        if (!ok) {
+            printError(i18nc("@info:shell", "Invalid calendar id: %1", collection));
+            return false;
+        }
+        mCollections.insert(id);
+    }
+
+    for (const auto &[option, date] : {std::pair{QStringLiteral("from"), &mFrom}, std::pair{QStringLiteral("to"), &mTo}}) {
+        if (parser.isSet(option)) {
+            *date = QDate::fromString(parser.value(option), Qt::ISODate);
+            if (!date->isValid()) {
+                printError(i18nc("@info:shell", "Invalid date: %1", parser.value(option)));
+                return false;
+            }
+        }
+    }
+
+    if (parser.isSet(QStringLiteral("filter"))) {
+        const QString name = parser.value(QStringLiteral("filter"));
+        const KSharedConfig::Ptr config = KSharedConfig::openConfig();
+        if (!config->hasGroup(QStringLiteral("Filter_") + name)) {
+            printError(i18nc("@info:shell", "Unknown filter: %1", name));
+            return false;
+        }
+        mFilter.reset(CalendarView::readFilter(config.data(), name));
+    }
+
+    if (parser.isSet(QStringLiteral("export"))) {
+        mAction = Action::Export;
+        mExportFile = QDir::current().absoluteFilePath(parser.value(QStringLiteral("export")));
+    } else if (parser.isSet(QStringLiteral("search"))) {
+        mAction = Action::Search;
+        mExpression = QRegularExpression(parser.value(QStringLiteral("search")), QRegularExpression::CaseInsensitiveOption);
+        if (!mExpression.isValid()) {
+            printError(i18nc("@info:shell", "Invalid regular expression: %1", mExpression.errorString()));
+            return false;
+        }
+    } else {
+        mAction = Action::Merge;
+        if (mCollections.size() != 1) {
+            printError(i18nc("@info:shell", "Merging needs the id of the destination calendar, given with --collection."));
+            return false;
+        }
+        const QStringList files = parser.positionalArguments();
+        for (const QString &file : files) {
+            mUrls.append(QUrl::fromUserInput(file, QDir::currentPath(), QUrl::AssumeLocalFile));
+        }
+        if (mUrls.isEmpty()) {
+            printError(i18nc("@info:shell", "No files to merge."));
+            return false;
+        }
+    }
+    return true;
+}
+
+void BatchMode::start()
+{
+    if (mAction == Action::Merge) {
+        merge();
+        return;
+    }
+
+    mCalendar = KCalendarCore::MemoryCalendar::Ptr(new KCalendarCore::MemoryCalendar(QTimeZone::systemTimeZone()));
+
+    // Only the requested calendars are loaded
+    Akonadi::CollectionFetchJob *job = nullptr;
+    if (mCollections.isEmpty()) {
+        job = new Akonadi::CollectionFetchJob(Akonadi::Collection::root(), Akonadi::CollectionFetchJob::Recursive, this);
+    } else {
+        Akonadi::Collection::List collections;
+        for (const Akonadi::Collection::Id id : std::as_const(mCollections)) {
+            collections.append(Akonadi::Collection(id));
+        }
+        job = new Akonadi::CollectionFetchJob(collections, Akonadi::CollectionFetchJob::Base, this);
+    }
+    job->fetchScope().setContentMimeTypes(incidenceMimeTypes());
+    connect(job, &KJob::result, this, &BatchMode::slotCollectionsFetched);
+}
+
+void BatchMode::slotCollectionsFetched(KJob *job)
+{
+    if (job->error()) {
+        fail(i18nc("@info:shell", "Could not load the calendars: %1", job->errorString()));
+        return;
+    }
+
+    const QStringList mimeTypes = incidenceMimeTypes();
+    const Akonadi::Collection::List collections = qobject_cast<Akonadi::CollectionFetchJob *>(job)->collections();
+    for (const Akonadi::Collection &collection : collections) {
+        const QStringList contentMimeTypes = collection.contentMimeTypes();
+        if (std::none_of(mimeTypes.cbegin(), mimeTypes.cend(), [&contentMimeTypes](const QString &mimeType) {
+                return contentMimeTypes.contains(mimeType);
+            })) {
+            continue;
+        }
+        // The items are handed over in batches and not kept by the job
+        auto fetchJob = new Akonadi::ItemFetchJob(collection, this);
+        fetchJob->fetchScope().fetchFullPayload();
+        fetchJob->setDeliveryOption(Akonadi::ItemFetchJob::EmitItemsInBatches);
+        connect(fetchJob, &Akonadi::ItemFetchJob::itemsReceived, this, &BatchMode::slotItemsReceived);
+        connect(fetchJob, &KJob::result, this, &BatchMode::slotItemFetchDone);
+        ++mPendingFetches;
+    }
+
+    if (mPendingFetches == 0) {
+        slotCalendarLoaded();
+    }
+}
+
+void BatchMode::slotItemsReceived(const Akonadi::Item::List &items)
+{
+    for (const Akonadi::Item &item : items) {
+        const KCalendarCore::Incidence::Ptr incidence = Akonadi::CalendarUtils::incidence(item);
+        if (incidence) {
+            mCalendar->addIncidence(incidence);
+        }
+    }
+}
+
+void BatchMode::slotItemFetchDone(KJob *job)
+{
+    if (mPendingFetches == 0) {
+        // A previous job failed already
+        return;
+    }
+    if (job->error()) {
+        mPendingFetches = 0;
+        fail(i18nc("@info:shell", "Could not load the calendars: %1", job->errorString()));
+        return;
+    }
+    if (--mPendingFetches == 0) {
+        slotCalendarLoaded();
+    }
+}
+
+void BatchMode::slotCalendarLoaded()
+{
+    // The calendar owns the filter it is given
+    mCalendar->setFilter(mFilter.release());
+    const KCalendarCore::Incidence::List incidences = selectedIncidences();
+    if (mAction == Action::Export) {
+        exportIncidences(incidences);
+    } else {
+        search(incidences);
+    }
+}
+
+KCalendarCore::Incidence::List BatchMode::selectedIncidences() const
+{
+    KCalendarCore::Incidence::List incidences;
+    if (mFrom.isValid() || mTo.isValid()) {
+        const QDate from = mFrom.isValid() ? mFrom : earliestDate;
+        const QDate to = mTo.isValid() ? mTo : latestDate;
+        const QTimeZone timeZone = mCalendar->timeZone();
+        const KCalendarCore::Event::List events = mCalendar->events(from, to, timeZone);
+        const KCalendarCore::Todo::List todos = mCalendar->todos(from, to, timeZone);
+        incidences.reserve(events.size() + todos.size());
+        for (const KCalendarCore::Event::Ptr &event : events) {
+            incidences.append(event);
+        }
+        for (const KCalendarCore::Todo::Ptr &todo : todos) {
+            incidences.append(todo);
+        }
+        const KCalendarCore::Journal::List journals = mCalendar->journals();
+        for (const KCalendarCore::Journal::Ptr &journal : journals) {
+            const QDate date = journal->dtStart().toTimeZone(timeZone).date();
+            if (date >= from && date <= to) {
+                incidences.append(journal);
+            }
+        }
+    } else {
+        // Already filtered by the calendar
+        incidences = mCalendar->incidences();
+    }
+    return incidences;
+}
+
+void BatchMode::exportIncidences(const KCalendarCore::Incidence::List &incidences)
+{
+    KCalendarCore::MemoryCalendar::Ptr calendar(new KCalendarCore::MemoryCalendar(mCalendar->timeZone()));
+    for (const KCalendarCore::Incidence::Ptr &incidence : incidences) {
+        calendar->addIncidence(KCalendarCore::Incidence::Ptr(incidence->clone()));
+    }
+
+    auto exporter = new ICalExporter(calendar, mExportFile, this);
+    connect(exporter, &ICalExporter::finished, this, [this, exporter, count = incidences.size()](bool success) {
+        if (!success) {
+            fail(i18nc("@info:shell", "Cannot write %1: %2", mExportFile, exporter->errorString()));
+            return;
+        }
+        QTextStream(stdout) << i18ncp("@info:shell", "Exported 1 incidence to %2", "Exported %1 incidences to %2", count, mExportFile) << '\n';
+        QCoreApplication::exit(0);
+    });
+    exporter->start();
+}
+
+void BatchMode::search(const KCalendarCore::Incidence::List &incidences)
+{
+    auto engine = new SearchEngine(this);
+    connect(engine, &SearchEngine::matchesFound, this, [](const KCalendarCore::Incidence::List &matches) {
+        QTextStream out(stdout);
+        for (const KCalendarCore::Incidence::Ptr &incidence : matches) {
+            const QDateTime start = incidence->dateTime(KCalendarCore::IncidenceBase::RoleDisplayStart);
+            out << (incidence->allDay() ? start.date().toString(Qt::ISODate) : start.toString(Qt::ISODate)) << '\t' << incidence->uid() << '\t'
+                << incidence->summary() << '\n';
+        }
+    });
+    connect(engine, &SearchEngine::finished, this, []() {
+        QCoreApplication::exit(0);
+    });
+    engine->start(incidences,
+                  mExpression,
+                  SearchEngine::Summary | SearchEngine::Description | SearchEngine::Categories | SearchEngine::Location | SearchEngine::Attendees);
+}
+
+void BatchMode::merge()
+{
+    auto importer = new CalendarImporter(Akonadi::Collection(*mCollections.cbegin()), this);
+    importer->setChunkSize(KOPrefs::instance()->importChunkSize());
+    importer->setMaximumFiles(KOPrefs::instance()->importParallelFiles());
+    for (const QUrl &url : std::as_const(mUrls)) {
+        importer->addUrl(url);
+    }
+    connect(importer, &CalendarImporter::finished, this, [](int imported, int skipped, const QStringList &errors) {
+        QTextStream(stdout) << i18ncp("@info:shell", "Imported 1 incidence", "Imported %1 incidences", imported) << ", "
+                            << i18ncp("@info:shell", "skipped 1 duplicate", "skipped %1 duplicates", skipped) << '\n';
+        for (const QString &error : errors) {
+            printError(error);
+        }
+        QCoreApplication::exit(errors.isEmpty() ? 0 : 1);
+    });
+    importer->start();
+}
+
+void BatchMode::fail(const QString &message)
+{
+    qCWarning(KORGANIZER_LOG) << message;
+    printError(message);
+    QCoreApplication::exit(1);
+}
+
+#include "moc_batchmode.cpp"
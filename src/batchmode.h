@@ -0,0 +1,88 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "korganizerprivate_export.h"
+
+#include <Akonadi/Collection>
+#include <Akonadi/Item>
+
+#include <KCalendarCore/CalFilter>
+#include <KCalendarCore/MemoryCalendar>
+
+#include <QDate>
+#include <QObject>
+#include <QRegularExpression>
+#include <QSet>
+#include <QUrl>
+
+#include <memory>
+
+class KJob;
+class QCommandLineParser;
+
+/**
+  Runs KOrganizer without user interface, for scripts and scheduled jobs.
+
+  Started with --batch, KOrganizer neither creates a main window nor
+  contacts a running instance. It runs a QCoreApplication, loads the
+  requested calendars once into a MemoryCalendar and then exports or
+  searches them, or merges files into one of them, and exits.
+
+  @short Headless command line mode
+*/
+class KORGANIZERPRIVATE_EXPORT BatchMode : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+      Returns whether the command line @p argv asks for batch mode.
+    */
+    [[nodiscard]] static bool isRequested(int argc, char **argv);
+
+    /**
+      Runs batch mode and returns the exit code of the process.
+    */
+    [[nodiscard]] static int run(int argc, char **argv);
+
+    ~BatchMode() override;
+
+private:
+    enum class Action {
+        Export,
+        Merge,
+        Search,
+    };
+
+    BatchMode();
+
+    [[nodiscard]] bool parseArguments(const QCommandLineParser &parser);
+    void start();
+    void slotCollectionsFetched(KJob *job);
+    void slotItemsReceived(const Akonadi::Item::List &items);
+    void slotItemFetchDone(KJob *job);
+    void slotCalendarLoaded();
+    [[nodiscard]] KCalendarCore::Incidence::List selectedIncidences() const;
+    void exportIncidences(const KCalendarCore::Incidence::List &incidences);
+    void search(const KCalendarCore::Incidence::List &incidences);
+    void merge();
+    void fail(const QString &message);
+
+    Action mAction = Action::Export;
+    QString mExportFile;
+    QRegularExpression mExpression;
+    QList<QUrl> mUrls;
+    QDate mFrom;
+    QDate mTo;
+    QSet<Akonadi::Collection::Id> mCollections;
+    std::unique_ptr<KCalendarCore::CalFilter> mFilter;
+    KCalendarCore::MemoryCalendar::Ptr mCalendar;
+    /** the item fetch jobs still running */
+    int mPendingFetches = 0;
+};
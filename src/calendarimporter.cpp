@@ -0,0 +1,397 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "calendarimporter.h"
+#include "korganizer_debug.h"
+
+#include <Akonadi/ItemCreateJob>
+#include <Akonadi/ItemFetchJob>
+#include <Akonadi/ItemFetchScope>
+#include <Akonadi/TransactionSequence>
+
+#include <KCalendarCore/ICalFormat>
+#include <KCalendarCore/MemoryCalendar>
+#include <KCalendarCore/VCalFormat>
+
+#include <Libkdepim/ProgressManager>
+
+#include <KIO/FileCopyJob>
+#include <KLocalizedString>
+
+#include <QFile>
+#include <QFuture>
+#include <QTemporaryDir>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+
+struct CalendarImporter::File {
+    QUrl url;
+    QString path;
+    std::unique_ptr<QTemporaryDir> downloadDir;
+    /** the VTIMEZONE components of the file, needed to parse each chunk */
+    QByteArray timeZones;
+    qint64 offset = 0;
+    bool atEnd = false;
+    /** incidences parsed but not created yet */
+    KCalendarCore::Incidence::List backlog;
+};
+
+using CalendarImport::ChunkResult;
+using CalendarImport::ScanResult;
+
+namespace
+{
+bool isCalendarLine(const QByteArray &line)
+{
+    return line.startsWith("BEGIN:VCALENDAR") || line.startsWith("END:VCALENDAR");
+}
+
+KCalendarCore::Incidence::List detachedIncidences(const KCalendarCore::MemoryCalendar::Ptr &calendar)
+{
+    // Copies, so that nothing refers to the calendar going away
+    KCalendarCore::Incidence::List result;
+    const KCalendarCore::Incidence::List incidences = calendar->rawIncidences();
+    result.reserve(incidences.size());
+    for (const KCalendarCore::Incidence::Ptr &incidence : incidences) {
+        result.append(KCalendarCore::Incidence::Ptr(incidence->clone()));
+    }
+    return result;
+}
+
+ChunkResult parseVCalendar(const QString &path)
+{
+    ChunkResult result;
+    result.atEnd = true;
+    KCalendarCore::MemoryCalendar::Ptr calendar(new KCalendarCore::MemoryCalendar(QTimeZone::systemTimeZone()));
+    KCalendarCore::VCalFormat format;
+    if (!format.load(calendar, path)) {
+        result.errorString = i18nc("@info", "The file could not be parsed.");
+        return result;
+    }
+    result.incidences = detachedIncidences(calendar);
+    return result;
+}
+}
+
+ScanResult CalendarImport::scanCalendarFile(const QString &path)
+{
+    ScanResult result;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.errorString = file.errorString();
+        return result;
+    }
+    int depth = 0;
+    bool inTimeZone = false;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (isCalendarLine(line)) {
+            continue;
+        }
+        if (depth == 0 && line.startsWith("VERSION:1.0")) {
+            result.vCalendar = true;
+            break;
+        }
+        if (line.startsWith("BEGIN:")) {
+            inTimeZone = inTimeZone || (depth == 0 && line.startsWith("BEGIN:VTIMEZONE"));
+            ++depth;
+        }
+        if (inTimeZone) {
+            result.timeZones += line;
+        }
+        if (line.startsWith("END:") && depth > 0) {
+            --depth;
+            inTimeZone = inTimeZone && depth > 0;
+        }
+    }
+    return result;
+}
+
+ChunkResult CalendarImport::parseChunk(const QString &path, qint64 offset, int count, const QByteArray &timeZones)
+{
+    ChunkResult result;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(offset)) {
+        result.errorString = file.errorString();
+        return result;
+    }
+
+    QByteArray text = "BEGIN:VCALENDAR\r\nVERSION:2.0\r\n" + timeZones;
+    int components = 0;
+    int depth = 0;
+    bool inTimeZone = false;
+    while (components < count && !file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (isCalendarLine(line) || (depth == 0 && !line.startsWith("BEGIN:"))) {
+            // The calendar properties are not needed
+            continue;
+        }
+        if (line.startsWith("BEGIN:")) {
+            inTimeZone = inTimeZone || (depth == 0 && line.startsWith("BEGIN:VTIMEZONE"));
+            ++depth;
+        }
+        if (!inTimeZone) {
+            text += line;
+        }
+        if (line.startsWith("END:")) {
+            --depth;
+            if (depth == 0) {
+                if (!inTimeZone) {
+                    ++components;
+                }
+                inTimeZone = false;
+            }
+        }
+    }
+    text += "END:VCALENDAR\r\n";
+    result.offset = file.pos();
+    result.atEnd = file.atEnd();
+
+    KCalendarCore::MemoryCalendar::Ptr calendar(new KCalendarCore::MemoryCalendar(QTimeZone::systemTimeZone()));
+    KCalendarCore::ICalFormat format;
+    if (!format.fromRawString(calendar, text)) {
+        result.errorString = i18nc("@info", "The file could not be parsed.");
+        return result;
+    }
+    result.incidences = detachedIncidences(calendar);
+    return result;
+}
+
+CalendarImporter::CalendarImporter(const Akonadi::Collection &destination, QObject *parent)
+    : QObject(parent)
+    , mDestination(destination)
+{
+}
+
+CalendarImporter::~CalendarImporter() = default;
+
+void CalendarImporter::setChunkSize(int size)
+{
+    mChunkSize = std::max(1, size);
+}
+
+int CalendarImporter::chunkSize() const
+{
+    return mChunkSize;
+}
+
+void CalendarImporter::setMaximumFiles(int count)
+{
+    mMaximumFiles = std::max(1, count);
+}
+
+int CalendarImporter::maximumFiles() const
+{
+    return mMaximumFiles;
+}
+
+void CalendarImporter::addUrl(const QUrl &url)
+{
+    auto file = std::make_shared<File>();
+    file->url = url;
+    mQueue.append(file);
+    ++mFileCount;
+}
+
+void CalendarImporter::start()
+{
+    mProgressItem = KPIM::ProgressManager::createProgressItem(KPIM::ProgressManager::getUniqueID(), i18nc("@info:progress", "Importing calendars"));
+    connect(mProgressItem, &KPIM::ProgressItem::progressItemCanceled, this, [this]() {
+        // Chunks being created are finished, nothing more is read
+        mCanceled = true;
+    });
+
+    // Only the UIDs of the calendar are needed to skip duplicates
+    auto job = new Akonadi::ItemFetchJob(mDestination, this);
+    job->fetchScope().fetchFullPayload(false);
+    job->fetchScope().setFetchGid(true);
+    job->fetchScope().setFetchModificationTime(false);
+    connect(job, &Akonadi::ItemFetchJob::itemsReceived, this, [this](const Akonadi::Item::List &items) {
+        for (const Akonadi::Item &item : items) {
+            if (!item.gid().isEmpty()) {
+                mExistingUids.insert(item.gid());
+            }
+        }
+    });
+    connect(job, &KJob::result, this, [this](KJob *job) {
+        if (job->error()) {
+            // Importing everything is better than importing nothing
+            qCWarning(KORGANIZER_LOG) << "Could not fetch the UIDs of collection" << mDestination.id() << job->errorString();
+        }
+        startFiles();
+    });
+}
+
+void CalendarImporter::startFiles()
+{
+    while (!mCanceled && mRunningFiles < mMaximumFiles && !mQueue.isEmpty()) {
+        // The throughput doesn't include fetching the UIDs
+        if (!mTimer.isValid()) {
+            mTimer.start();
+        }
+        ++mRunningFiles;
+        openFile(mQueue.takeFirst());
+    }
+    if (mRunningFiles > 0) {
+        return;
+    }
+
+    if (mProgressItem) {
+        mProgressItem->setComplete();
+    }
+    Q_EMIT finished(mImported, mSkipped, mErrors);
+    deleteLater();
+}
+
+void CalendarImporter::openFile(const FilePtr &file)
+{
+    if (file->url.isLocalFile()) {
+        file->path = file->url.toLocalFile();
+        scanFile(file);
+        return;
+    }
+
+    file->downloadDir = std::make_unique<QTemporaryDir>();
+    file->path = file->downloadDir->filePath(QStringLiteral("import.ics"));
+    auto job = KIO::file_copy(file->url, QUrl::fromLocalFile(file->path), -1, KIO::Overwrite | KIO::HideProgressInfo);
+    connect(job, &KJob::result, this, [this, file](KJob *job) {
+        if (job->error()) {
+            fileDone(file, job->errorString());
+        } else {
+            scanFile(file);
+        }
+    });
+}
+
+void CalendarImporter::scanFile(const FilePtr &file)
+{
+    QtConcurrent::run(CalendarImport::scanCalendarFile, file->path).then(this, [this, file](const ScanResult &result) {
+        if (!result.errorString.isEmpty()) {
+            fileDone(file, result.errorString);
+            return;
+        }
+        if (!result.vCalendar) {
+            file->timeZones = result.timeZones;
+            readNext(file);
+            return;
+        }
+        QtConcurrent::run(parseVCalendar, file->path).then(this, [this, file](const ChunkResult &result) {
+            if (!result.errorString.isEmpty()) {
+                fileDone(file, result.errorString);
+                return;
+            }
+            file->atEnd = true;
+            file->backlog = result.incidences;
+            readNext(file);
+        });
+    });
+}
+
+void CalendarImporter::readNext(const FilePtr &file)
+{
+    if (mCanceled) {
+        fileDone(file);
+    } else if (!file->backlog.isEmpty()) {
+        createItems(file);
+    } else if (file->atEnd) {
+        fileDone(file);
+    } else {
+        QtConcurrent::run(CalendarImport::parseChunk, file->path, file->offset, mChunkSize, file->timeZones).then(this, [this, file](const ChunkResult &result) {
+            if (!result.errorString.isEmpty()) {
+                fileDone(file, result.errorString);
+                return;
+            }
+            file->offset = result.offset;
+            file->atEnd = result.atEnd;
+            file->backlog = result.incidences;
+            readNext(file);
+        });
+    }
+}
+
+void CalendarImporter::createItems(const FilePtr &file)
+{
+    const qsizetype count = std::min<qsizetype>(mChunkSize, file->backlog.size());
+    const KCalendarCore::Incidence::List chunk = file->backlog.first(count);
+    file->backlog.remove(0, count);
+
+    Akonadi::TransactionSequence *transaction = nullptr;
+    int created = 0;
+    for (const KCalendarCore::Incidence::Ptr &incidence : chunk) {
+        if (isDuplicate(incidence)) {
+            ++mSkipped;
+            continue;
+        }
+        if (!transaction) {
+            transaction = new Akonadi::TransactionSequence(this);
+        }
+        Akonadi::Item item;
+        item.setMimeType(incidence->mimeType());
+        item.setPayload<KCalendarCore::Incidence::Ptr>(incidence);
+        new Akonadi::ItemCreateJob(item, mDestination, transaction);
+        ++created;
+    }
+
+    if (!transaction) {
+        updateProgress();
+        readNext(file);
+        return;
+    }
+    connect(transaction, &KJob::result, this, [this, file, created](KJob *job) {
+        if (job->error()) {
+            fileDone(file, job->errorString());
+            return;
+        }
+        mImported += created;
+        updateProgress();
+        readNext(file);
+    });
+}
+
+bool CalendarImporter::isDuplicate(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    // Exceptions of a recurrence share the UID of the series
+    const QString key = incidence->uid() + u'|' + incidence->recurrenceId().toString(Qt::ISODateWithMs);
+    if (mExistingUids.contains(incidence->uid()) || mImportedKeys.contains(key)) {
+        return true;
+    }
+    mImportedKeys.insert(key);
+    return false;
+}
+
+void CalendarImporter::fileDone(const FilePtr &file, const QString &errorString)
+{
+    if (!errorString.isEmpty()) {
+        qCWarning(KORGANIZER_LOG) << "Importing" << file->url << "failed:" << errorString;
+        mErrors.append(xi18nc("@info", "<filename>%1</filename>: %2", file->url.toDisplayString(), errorString));
+    }
+    file->backlog.clear();
+    file->downloadDir.reset();
+    ++mFilesDone;
+    --mRunningFiles;
+    updateProgress();
+    startFiles();
+}
+
+void CalendarImporter::updateProgress()
+{
+    if (!mProgressItem) {
+        return;
+    }
+    const qint64 elapsed = std::max<qint64>(1, mTimer.elapsed());
+    const qint64 perSecond = mImported * 1000 / elapsed;
+    mProgressItem->setProgress(100 * mFilesDone / std::max(1, mFileCount));
+    mProgressItem->setStatus(i18ncp("@info:progress",
+                                    "1 incidence imported (%2 per second)",
+                                    "%1 incidences imported (%2 per second)",
+                                    mImported,
+                                    perSecond));
+}
+
+#include "moc_calendarimporter.cpp"
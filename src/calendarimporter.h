@@ -0,0 +1,149 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "korganizerprivate_export.h"
+
+#include <Akonadi/Collection>
+
+#include <KCalendarCore/Incidence>
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QUrl>
+
+#include <memory>
+
+namespace KPIM
+{
+class ProgressItem;
+}
+
+/**
+  The parsing steps of CalendarImporter. They only read the file they are
+  given, so they can run on worker threads.
+*/
+namespace CalendarImport
+{
+struct ScanResult {
+    /** the VTIMEZONE components of the file, needed to parse each chunk */
+    QByteArray timeZones;
+    /** true for vCalendar files, which are parsed as a whole */
+    bool vCalendar = false;
+    QString errorString;
+};
+
+struct ChunkResult {
+    KCalendarCore::Incidence::List incidences;
+    /** the file offset the next chunk starts at */
+    qint64 offset = 0;
+    bool atEnd = false;
+    QString errorString;
+};
+
+/**
+  Collects the time zones of the iCalendar file @p path and tells vCalendar
+  files apart.
+*/
+[[nodiscard]] KORGANIZERPRIVATE_EXPORT ScanResult scanCalendarFile(const QString &path);
+
+/**
+  Parses the next @p count components of the iCalendar file @p path,
+  starting at @p offset, with the time zones found by scanCalendarFile().
+*/
+[[nodiscard]] KORGANIZERPRIVATE_EXPORT ChunkResult parseChunk(const QString &path, qint64 offset, int count, const QByteArray &timeZones);
+}
+
+/**
+  Imports iCalendar and vCalendar files into an existing calendar.
+
+  The files are read and parsed incrementally on worker threads, a chunk of
+  incidences at a time, and each chunk is created in one Akonadi
+  transaction. At most maximumFiles() files are imported at the same time,
+  each with at most one chunk in flight, which bounds the memory used.
+
+  Incidences whose UID already exists in the destination, or which occur
+  twice in the imported files, are skipped.
+
+  The progress and the throughput are shown in the status bar, where the
+  import can also be canceled. The importer deletes itself when it is
+  finished.
+
+  @short Chunked import of calendar files
+*/
+class KORGANIZERPRIVATE_EXPORT CalendarImporter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit CalendarImporter(const Akonadi::Collection &destination, QObject *parent = nullptr);
+    ~CalendarImporter() override;
+
+    /** Sets the number of incidences parsed and created at once. */
+    void setChunkSize(int size);
+    [[nodiscard]] int chunkSize() const;
+
+    /** Sets the number of files imported at the same time. */
+    void setMaximumFiles(int count);
+    [[nodiscard]] int maximumFiles() const;
+
+    /**
+      Adds @p url to the files to import. Remote files are downloaded first.
+    */
+    void addUrl(const QUrl &url);
+
+    /**
+      Starts importing the files added.
+    */
+    void start();
+
+Q_SIGNALS:
+    /**
+      Emitted when all files were imported. @p imported is the number of
+      incidences created, @p skipped the number of duplicates, @p errors
+      describes the files which failed.
+    */
+    void finished(int imported, int skipped, const QStringList &errors);
+
+private:
+    struct File;
+    using FilePtr = std::shared_ptr<File>;
+
+    void startFiles();
+    void openFile(const FilePtr &file);
+    void scanFile(const FilePtr &file);
+    void readNext(const FilePtr &file);
+    void createItems(const FilePtr &file);
+    void fileDone(const FilePtr &file, const QString &errorString = {});
+    void updateProgress();
+    [[nodiscard]] bool isDuplicate(const KCalendarCore::Incidence::Ptr &incidence);
+
+    const Akonadi::Collection mDestination;
+    int mChunkSize = 500;
+    int mMaximumFiles = 2;
+
+    QList<FilePtr> mQueue;
+    int mRunningFiles = 0;
+    int mFileCount = 0;
+    int mFilesDone = 0;
+
+    /** UIDs present in the destination before the import */
+    QSet<QString> mExistingUids;
+    /** UIDs and recurrence ids of the incidences imported */
+    QSet<QString> mImportedKeys;
+
+    int mImported = 0;
+    int mSkipped = 0;
+    QStringList mErrors;
+    QElapsedTimer mTimer;
+    QPointer<KPIM::ProgressItem> mProgressItem;
+    bool mCanceled = false;
+};
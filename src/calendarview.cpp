@@ -22,6 +22,10 @@
 #include "datenavigator.h"
 #include "datenavigatorcontainer.h"
 #include "dialog/koeventviewerdialog.h"
+#include "dialog/searchindex.h"
+#include "dialog/searchindexer.h"
+#include "icalexporter.h"
+#include "incidencetransfer.h"
 #include "kodaymatrix.h"
 #include "kodialogmanager.h"
 #include "koglobals.h"
@@ -29,6 +33,7 @@
 #include "pastehelper.h"
 #include "pimmessagebox.h"
 #include "prefs/koprefs.h"
+#include "startuptrace.h"
 #include "views/agendaview/koagendaview.h"
 #include "views/monthview/komonthview.h"
 #include "views/todoview/kotodoview.h"
@@ -65,10 +70,6 @@
 #include <KCalendarCore/FileStorage>
 #include <KCalendarCore/ICalFormat>
 
-#if KCALENDARCORE_VERSION < QT_VERSION_CHECK(6, 30, 0)
-#include <KCalUtils/Stringify>
-#endif
-
 #include <TextAddonsWidgets/WhatsNewNgDialog>
 
 #include <PimCommonAkonadi/CollectionAclPage>
@@ -84,7 +85,11 @@
 #include <QFileDialog>
 #include <QSplitter>
 #include <QStackedWidget>
+#include <QTimer>
 #include <QVBoxLayout>
+
+#include <algorithm>
+#include <utility>
 using namespace Qt::Literals::StringLiterals;
 // Meaningful aliases for dialog box return codes.
 namespace
@@ -101,6 +106,8 @@ enum ItemActions {
 CalendarView::CalendarView(QWidget *parent)
     : CalendarViewBase(parent)
 {
+    KOrg::StartupTrace::Phase phase("CalendarView");
+
     Akonadi::ControlGui::widgetNeedsAkonadi(this);
     mChanger = new Akonadi::IncidenceChanger(new IncidenceEditorNG::IndividualMailComponentFactory(this), this);
     mChanger->setDefaultCollection(Akonadi::Collection(CalendarSupport::KCalPrefs::instance()->defaultEventCalendarId()));
@@ -118,8 +125,6 @@ CalendarView::CalendarView(QWidget *parent)
 
     mCalendar->setObjectName(QLatin1StringView("KOrg Calendar"));
     mCalendarClipboard = new Akonadi::CalendarClipboard(mCalendar, mChanger, this);
-    mITIPHandler = new Akonadi::ITIPHandler(this);
-    mITIPHandler->setCalendar(mCalendar);
     connect(mCalendarClipboard, &Akonadi::CalendarClipboard::cutFinished, this, &CalendarView::onCutFinished);
 
     mChanger->setEntityTreeModel(mCalendar->entityTreeModel());
@@ -138,10 +143,6 @@ CalendarView::CalendarView(QWidget *parent)
 
     mViewManager = new KOViewManager(this);
     mDialogManager = new KODialogManager(this);
-    mTodoPurger = new Akonadi::TodoPurger(this);
-    mTodoPurger->setCalendar(mCalendar);
-    mTodoPurger->setIncidenceChager(mChanger);
-    connect(mTodoPurger, &Akonadi::TodoPurger::todosPurged, this, &CalendarView::onTodosPurged);
 
     mReadOnly = false;
     mSplitterSizesValid = false;
@@ -169,11 +170,18 @@ CalendarView::CalendarView(QWidget *parent)
 
     mDateNavigatorContainer = new DateNavigatorContainer(mLeftSplitter);
     mDateNavigatorContainer->setObjectName(QLatin1StringView("CalendarView::DateNavigator"));
+    mDateNavigatorContainer->setOccurrenceCache(&mOccurrenceCache);
 
     mTodoList = new KOTodoView(true /*sidebar*/, mLeftSplitter);
     mTodoList->setObjectName(QLatin1StringView("todolist"));
-    connect(this, &CalendarView::calendarAdded, mTodoList, &KOTodoView::calendarAdded);
-    connect(this, &CalendarView::calendarRemoved, mTodoList, &KOTodoView::calendarRemoved);
+    connect(this, &CalendarView::calendarsChanged, mTodoList, [this](const auto &added, const auto &removed) {
+        for (const auto &calendar : removed) {
+            mTodoList->calendarRemoved(calendar);
+        }
+        for (const auto &calendar : added) {
+            mTodoList->calendarAdded(calendar);
+        }
+    });
 
     mEventViewerBox = new QWidget(mLeftSplitter);
     auto mEventViewerBoxVBoxLayout = new QVBoxLayout(mEventViewerBox);
@@ -287,28 +295,24 @@ CalendarView::CalendarView(QWidget *parent)
     connect(mTodoList, &BaseView::incidenceSelected, this, &CalendarView::processTodoListSelection);
     disconnect(mTodoList, &BaseView::incidenceSelected, this, &CalendarView::processMainViewSelection);
 
-    {
-        static bool pageRegistered = false;
-
-        if (!pageRegistered) {
-            Akonadi::CollectionPropertiesDialog::registerPage(new CalendarSupport::CollectionGeneralPageFactory);
-            Akonadi::CollectionPropertiesDialog::registerPage(new PimCommon::CollectionAclPageFactory);
-            Akonadi::CollectionPropertiesDialog::registerPage(new Akonadi::CollectionMaintenancePageFactory);
-            pageRegistered = true;
-        }
-    }
-
     const KAboutData aboutData = KAboutData::fromAppStreamId(u"org.kde.korganizer"_s);
     mReleasesInfo = aboutData.releases();
 
-    Akonadi::FreeBusyManager::self()->setCalendar(mCalendar);
-
     mCalendar->registerObserver(this);
+    mCalendar->registerObserver(&mOccurrenceCache);
+
+    // Nothing of this is visible, so it waits for the first frame
+    KOrg::StartupTrace::afterFirstPaint(this, [this]() {
+        KOrg::StartupTrace::Phase phase("CalendarView: deferred setup");
+        setupFreeBusyManager();
+        registerCollectionPropertyPages();
+    });
 }
 
 CalendarView::~CalendarView()
 {
     mCalendar->unregisterObserver(this);
+    mCalendar->unregisterObserver(&mOccurrenceCache);
     mCalendar->setFilter(nullptr); // So calendar doesn't deleted it twice
     forEachCalendar([](const auto &calendar) {
         calendar->setFilter(nullptr);
@@ -345,26 +349,23 @@ QList<Akonadi::CollectionCalendar::Ptr> &CalendarView::enabledCalendars()
     return mEnabledCalendars;
 }
 
-Akonadi::CollectionCalendar::Ptr CalendarView::calendarForCollection(const Akonadi::Collection &collection)
+Akonadi::CollectionCalendar::Ptr CalendarView::enabledCalendar(Akonadi::Collection::Id collectionId) const
 {
-    auto it = mCalendars.begin();
-    while (it != mCalendars.end()) {
-        if (it->isNull()) {
-            it = mCalendars.erase(it);
-            continue;
-        }
+    return mEnabledCalendarsById.value(collectionId);
+}
 
-        const auto calendarIt = it->toStrongRef();
-        if (calendarIt->collection() == collection) {
-            return calendarIt;
+Akonadi::CollectionCalendar::Ptr CalendarView::calendarForCollection(const Akonadi::Collection &collection)
+{
+    const auto it = mCalendars.constFind(collection.id());
+    if (it != mCalendars.cend()) {
+        if (const auto calendar = it->toStrongRef()) {
+            return calendar;
         }
-
-        ++it;
     }
 
     const auto newCalendar = Akonadi::CollectionCalendar::Ptr::create(eventsModel(), collection);
     newCalendar->setFilter(mCurrentFilter);
-    mCalendars.emplace_back(newCalendar);
+    mCalendars.insert(collection.id(), newCalendar);
     return newCalendar;
 }
 
@@ -447,6 +448,8 @@ bool CalendarView::saveCalendar(const QString &filename)
     // Store back all unsaved data into calendar object
     mViewManager->currentView()->flushView();
 
+    // Synchronous callers get FileStorage; a streaming export would have to
+    // process events while the file is half-written
     KCalendarCore::FileStorage storage(mCalendar);
     storage.setFileName(filename);
     storage.setSaveFormat(new KCalendarCore::ICalFormat);
@@ -461,6 +464,8 @@ void CalendarView::archiveCalendar()
 
 void CalendarView::readSettings()
 {
+    KOrg::StartupTrace::Phase phase("CalendarView::readSettings");
+
     // read settings from the KConfig, supplying reasonable
     // defaults where none are to be found
 
@@ -542,16 +547,7 @@ void CalendarView::readFilterSettings(KConfig *config)
     QStringList::ConstIterator it = filterList.constBegin();
     QStringList::ConstIterator const end = filterList.constEnd();
     while (it != end) {
-        auto filter = new KCalendarCore::CalFilter(*it);
-        KConfigGroup const filterConfig(config, QStringLiteral("Filter_") + (*it));
-        filter->setCriteria(filterConfig.readEntry("Criteria", 0));
-        filter->setCategoryList(filterConfig.readEntry("CategoryList", QStringList()));
-        if (filter->criteria() & KCalendarCore::CalFilter::HideNoMatchingAttendeeTodos) {
-            filter->setEmailList(CalendarSupport::KCalPrefs::instance()->allEmails());
-        }
-        filter->setCompletedTimeSpan(filterConfig.readEntry("HideTodoDays", 0));
-        mFilters.append(filter);
-
+        mFilters.append(readFilter(config, *it));
         ++it;
     }
 
@@ -563,6 +559,19 @@ void CalendarView::readFilterSettings(KConfig *config)
     updateFilter();
 }
 
+KCalendarCore::CalFilter *CalendarView::readFilter(const KConfig *config, const QString &name)
+{
+    auto filter = new KCalendarCore::CalFilter(name);
+    KConfigGroup const filterConfig(config, QStringLiteral("Filter_") + name);
+    filter->setCriteria(filterConfig.readEntry("Criteria", 0));
+    filter->setCategoryList(filterConfig.readEntry("CategoryList", QStringList()));
+    if (filter->criteria() & KCalendarCore::CalFilter::HideNoMatchingAttendeeTodos) {
+        filter->setEmailList(CalendarSupport::KCalPrefs::instance()->allEmails());
+    }
+    filter->setCompletedTimeSpan(filterConfig.readEntry("HideTodoDays", 0));
+    return filter;
+}
+
 void CalendarView::writeFilterSettings(KConfig *config)
 {
     static QRegularExpression const re(QStringLiteral("^Filter_.*"));
@@ -676,6 +685,17 @@ void CalendarView::updateConfig()
     }
 }
 
+SearchIndexer *CalendarView::searchIndexer()
+{
+    // Created when the search dialog first needs it, so that loading and
+    // filling the index never slows down the startup
+    if (!mSearchIndexer) {
+        mSearchIndex = new SearchIndex(SearchIndex::defaultFileName(), this);
+        mSearchIndexer = new SearchIndexer(mSearchIndex, mCalendar, this);
+    }
+    return mSearchIndexer;
+}
+
 void CalendarView::slotCreateFinished(int changeId, const Akonadi::Item &item, Akonadi::IncidenceChanger::ResultCode resultCode, const QString &errorString)
 {
     Q_UNUSED(changeId)
@@ -786,6 +806,9 @@ void CalendarView::endMultiModify()
 
 void CalendarView::changeIncidenceDisplay(const Akonadi::Item &item, Akonadi::IncidenceChanger::ChangeType changeType)
 {
+    // The views are refreshed right away, don't let them see the old occurrences
+    mOccurrenceCache.invalidate(Akonadi::CalendarUtils::incidence(item));
+
     if (mDateNavigatorContainer->isVisible()) {
         mDateNavigatorContainer->updateView();
     }
@@ -1499,143 +1522,84 @@ void CalendarView::toggleOccurrenceCompleted(const Akonadi::Item &todoItem, cons
 
 void CalendarView::copyIncidenceToResource(const Akonadi::Item &item, const Akonadi::Collection &col)
 {
-#ifdef AKONADI_PORT_DISABLED
-    if (!incidence) {
-        qCCritical(KORGANIZER_LOG) << "Null incidence";
-        return;
-    }
-
-    KCalendarCore::CalendarResources *const resources = KOrg::StdCalendar::self();
-    KCalendarCore::CalendarResourceManager *const manager = resources->resourceManager();
-
-    // Find the resource the incidence should be copied to
-    ResourceCalendar *newCal = nullptr;
-    KCalendarCore::CalendarResourceManager::iterator it;
-    for (it = manager->begin(); it != manager->end(); ++it) {
-        ResourceCalendar *const resource = *it;
-        if (resource->identifier() == resourceId) {
-            newCal = resource;
-            break;
-        }
-    }
-    if (!newCal) {
-        return;
-    }
-
-    // Clone a new Incidence from the selected Incidence and give it a new Uid.
-    KCalendarCore::Incidence::Ptr newInc;
-    if (incidence->type() == KCalendarCore::Incidence::TypeEvent) {
-        KCalendarCore::Event::Ptr nEvent(static_cast<KCalendarCore::Event::Ptr>(incidence)->clone());
-        nEvent->setUid(KCalendarCore::CalFormat::createUniqueId());
-        newInc = nEvent;
-    } else if (incidence->type() == KCalendarCore::Incidence::TypeTodo) {
-        KCalendarCore::Todo::Ptr nTodo(static_cast<KCalendarCore::Todo::Ptr>(incidence)->clone());
-        nTodo->setUid(KCalendarCore::CalFormat::createUniqueId());
-        newInc = nTodo;
-    } else if (incidence->type() == KCalendarCore::Incidence::TypeJournal) {
-        KCalendarCore::Journal::Ptr nJournal(static_cast<KCalendarCore::Journal::Ptr>(incidence)->clone());
-        nJournal->setUid(KCalendarCore::CalFormat::createUniqueId());
-        newInc = nJournal;
-    } else {
-        qCWarning(KORGANIZER_LOG) << "Trying to copy an incidence type that cannot be copied";
-        return;
-    }
-
-    if (resources->addIncidence(newInc, newCal)) {
-        incidenceAddFinished(newInc, true);
-        KMessageBox::information(this,
-                                 i18nc("@info", "\"%1\" was successfully copied to %2.", incidence->summary(), newCal->resourceName()),
-                                 i18nc("@title:window", "Copying Succeeded"),
-                                 "CalendarIncidenceCopy");
-    } else {
-        KMessageBox::error(this,
-                           i18nc("@info", "Unable to copy the item \"%1\" to %2.", incidence->summary(), newCal->resourceName()),
-                           i18nc("@title:window", "Copying Failed"));
-    }
-#else
-    Q_UNUSED(col)
-    Q_UNUSED(item)
-    qCDebug(KORGANIZER_LOG) << "AKONADI PORT: Disabled code in  " << Q_FUNC_INFO;
-#endif
+    transferIncidences(IncidenceTransfer::Copy, item, col);
 }
 
 void CalendarView::moveIncidenceToResource(const Akonadi::Item &item, const Akonadi::Collection &col)
 {
-#ifdef AKONADI_PORT_DISABLED
-    if (!incidence) {
-        qCCritical(KORGANIZER_LOG) << "Null incidence";
+    transferIncidences(IncidenceTransfer::Move, item, col);
+}
+
+void CalendarView::transferIncidences(IncidenceTransfer::Mode mode, const Akonadi::Item &item, const Akonadi::Collection &col)
+{
+    if (!item.isValid() || !col.isValid()) {
+        qCWarning(KORGANIZER_LOG) << "Invalid item or destination collection";
         return;
     }
 
-    KCalendarCore::CalendarResources *const resources = KOrg::StdCalendar::self();
-    KCalendarCore::CalendarResourceManager *const manager = resources->resourceManager();
-
-    // Find the resource the incidence should be moved to
-    ResourceCalendar *newCal = nullptr;
-    KCalendarCore::CalendarResourceManager::iterator it;
-    for (it = manager->begin(); it != manager->end(); ++it) {
-        ResourceCalendar *const resource = *it;
-        if (resource->identifier() == resourceId) {
-            newCal = resource;
-            break;
-        }
+    // The popup menu acts on the whole selection if the item is part of it
+    Akonadi::Item::List items;
+    if (KOrg::BaseView *const view = mViewManager->currentView()) {
+        items = view->selectedIncidences();
     }
-    if (!newCal) {
-        return;
+    const auto isItem = [&item](const Akonadi::Item &selected) {
+        return selected.id() == item.id();
+    };
+    if (std::ranges::none_of(items, isItem)) {
+        items = {item};
     }
 
-    // Clone a new Incidence from the selected Incidence and give it a new Uid.
-    KCalendarCore::Incidence *newInc;
-    if (incidence->type() == KCalendarCore::Incidence::TypeEvent) {
-        KCalendarCore::Event::Ptr nEvent = static_cast<KCalendarCore::Event::Ptr>(incidence)->clone();
-        nEvent->setUid(KCalendarCore::CalFormat::createUniqueId());
-        newInc = nEvent;
-    } else if (incidence->type() == KCalendarCore::Incidence::TypeTodo) {
-        KCalendarCore::Todo::Ptr nTodo = static_cast<KCalendarCore::Todo::Ptr>(incidence)->clone();
-        nTodo->setUid(KCalendarCore::CalFormat::createUniqueId());
-        newInc = nTodo;
-    } else if (incidence->type() == KCalendarCore::Incidence::TypeJournal) {
-        KCalendarCore::Journal::Ptr nJournal = static_cast<KCalendarCore::Journal::Ptr>(incidence)->clone();
-        nJournal->setUid(KCalendarCore::CalFormat::createUniqueId());
-        newInc = nJournal;
-    } else {
-        qCWarning(KORGANIZER_LOG) << "Trying to move an incidence type that cannot be moved";
+    const QString destinationName = Akonadi::CalendarUtils::displayName(mCalendar->entityTreeModel(), col);
+    int readOnly = 0;
+    std::erase_if(items, [this, mode, &col, &readOnly](const Akonadi::Item &selected) {
+        if (!selected.isValid() || selected.parentCollection().id() == col.id()) {
+            return true;
+        }
+        if (mode == IncidenceTransfer::Move && !mCalendar->hasRight(selected, Akonadi::Collection::CanDeleteItem)) {
+            ++readOnly;
+            return true;
+        }
+        return false;
+    });
+    if (readOnly > 0) {
+        KMessageBox::information(this,
+                                 i18ncp("@info",
+                                        "One item belongs to a read-only calendar and will not be moved.",
+                                        "%1 items belong to a read-only calendar and will not be moved.",
+                                        readOnly),
+                                 i18nc("@title:window", "Moving Items"));
+    }
+    if (items.isEmpty()) {
         return;
     }
 
-    if (resources->addIncidence(newInc, newCal)) {
-        incidenceAddFinished(newInc, true);
-        ResourceCalendar *const oldCal = resources->resource(incidence);
-        if (!oldCal || resources->deleteIncidence(incidence)) {
-            KMessageBox::error(this,
-                               i18nc("@info",
-                                     "Unable to remove the item \"%1\" from the original calendar. "
-                                     "However, a copy of this item has been put into %2",
-                                     incidence->summary(),
-                                     newCal->resourceName()),
-                               i18nc("@title:window", "Moving Failed"));
-        } else {
-            incidenceDeleteFinished(incidence, true);
-            KMessageBox::information(
-                this,
-                i18nc("@info", "\"%1\" was successfully moved from %2 to %3.", incidence->summary(), oldCal->resourceName(), newCal->resourceName()),
-                i18nc("@title:window", "Moving Succeeded"),
-                "CalendarIncidenceMove");
+    auto transfer = new IncidenceTransfer(mode, items, col, history(), this);
+    connect(transfer, &IncidenceTransfer::finished, this, [this, mode, destinationName, count = items.size()](int transferred, const QString &errorString) {
+        if (!errorString.isEmpty()) {
+            if (mode == IncidenceTransfer::Copy) {
+                KMessageBox::error(this,
+                                   i18nc("@info", "Unable to copy the items to %1: %2", destinationName, errorString),
+                                   i18nc("@title:window", "Copying Failed"));
+            } else {
+                KMessageBox::error(this,
+                                   i18nc("@info", "Unable to move the items to %1: %2", destinationName, errorString),
+                                   i18nc("@title:window", "Moving Failed"));
+            }
+        } else if (transferred == count) {
+            if (mode == IncidenceTransfer::Copy) {
+                KMessageBox::information(this,
+                                         i18ncp("@info", "One item was successfully copied to %2.", "%1 items were successfully copied to %2.", transferred, destinationName),
+                                         i18nc("@title:window", "Copying Succeeded"),
+                                         QStringLiteral("CalendarIncidenceCopy"));
+            } else {
+                KMessageBox::information(this,
+                                         i18ncp("@info", "One item was successfully moved to %2.", "%1 items were successfully moved to %2.", transferred, destinationName),
+                                         i18nc("@title:window", "Moving Succeeded"),
+                                         QStringLiteral("CalendarIncidenceMove"));
+            }
         }
-    } else {
-        KMessageBox::error(this,
-                           i18nc("@info",
-                                 "Unable to add the item \"%1\" into %2. "
-                                 "This item has not been moved.",
-                                 incidence->summary(),
-                                 newCal->resourceName()),
-                           i18nc("@title:window", "Moving Failed"));
-    }
-#else
-    Q_UNUSED(col)
-    Q_UNUSED(item)
-    qCDebug(KORGANIZER_LOG) << "AKONADI PORT: Disabled code in  " << Q_FUNC_INFO;
-#endif
+    });
+    transfer->start();
 }
 
 QDateTime CalendarView::recurrenceOnDate(const KCalendarCore::Incidence::Ptr &incidence, const QDate &displayDate)
@@ -1727,7 +1691,7 @@ void CalendarView::schedule_publish(const Akonadi::Item &item)
 
     KCalendarCore::Incidence::Ptr const incidence = Akonadi::CalendarUtils::incidence(selectedItem);
     if (incidence) {
-        mITIPHandler->publishInformation(incidence, this);
+        itipHandler()->publishInformation(incidence, this);
     }
 }
 
@@ -1766,20 +1730,62 @@ void CalendarView::schedule_forward(const Akonadi::Item &item)
     KCalendarCore::Incidence::Ptr const incidence = Akonadi::CalendarUtils::incidence(selectedItem);
 
     if (incidence) {
-        mITIPHandler->sendAsICalendar(incidence, this);
+        itipHandler()->sendAsICalendar(incidence, this);
     }
 }
 
 void CalendarView::mailFreeBusy(int daysToPublish)
 {
+    setupFreeBusyManager();
     Akonadi::FreeBusyManager::self()->mailFreeBusy(daysToPublish, this);
 }
 
 void CalendarView::uploadFreeBusy()
 {
+    setupFreeBusyManager();
     Akonadi::FreeBusyManager::self()->publishFreeBusy(this);
 }
 
+Akonadi::ITIPHandler *CalendarView::itipHandler()
+{
+    if (!mITIPHandler) {
+        mITIPHandler = new Akonadi::ITIPHandler(this);
+        mITIPHandler->setCalendar(mCalendar);
+    }
+    return mITIPHandler;
+}
+
+Akonadi::TodoPurger *CalendarView::todoPurger()
+{
+    if (!mTodoPurger) {
+        mTodoPurger = new Akonadi::TodoPurger(this);
+        mTodoPurger->setCalendar(mCalendar);
+        mTodoPurger->setIncidenceChager(mChanger);
+        connect(mTodoPurger, &Akonadi::TodoPurger::todosPurged, this, &CalendarView::onTodosPurged);
+    }
+    return mTodoPurger;
+}
+
+void CalendarView::setupFreeBusyManager()
+{
+    if (!mFreeBusyManagerReady) {
+        Akonadi::FreeBusyManager::self()->setCalendar(mCalendar);
+        mFreeBusyManagerReady = true;
+    }
+}
+
+void CalendarView::registerCollectionPropertyPages()
+{
+    static bool pageRegistered = false;
+
+    if (!pageRegistered) {
+        Akonadi::CollectionPropertiesDialog::registerPage(new CalendarSupport::CollectionGeneralPageFactory);
+        Akonadi::CollectionPropertiesDialog::registerPage(new PimCommon::CollectionAclPageFactory);
+        Akonadi::CollectionPropertiesDialog::registerPage(new Akonadi::CollectionMaintenancePageFactory);
+        pageRegistered = true;
+    }
+}
+
 void CalendarView::schedule(KCalendarCore::iTIPMethod method, const Akonadi::Item &item)
 {
     Akonadi::Item selectedItem = item;
@@ -1790,7 +1796,7 @@ void CalendarView::schedule(KCalendarCore::iTIPMethod method, const Akonadi::Ite
     KCalendarCore::Incidence::Ptr const incidence = Akonadi::CalendarUtils::incidence(selectedItem);
 
     if (incidence) {
-        mITIPHandler->sendiTIPMessage(method, incidence, this);
+        itipHandler()->sendiTIPMessage(method, incidence, this);
     }
 }
 
@@ -1894,24 +1900,22 @@ void CalendarView::exportICalendar()
                 return;
             }
         }
-        auto format = new KCalendarCore::ICalFormat;
-
-        KCalendarCore::FileStorage storage(mCalendar, filename, format);
-        if (!storage.save()) {
-            QString errmess;
-            if (format->exception()) {
-#if KCALENDARCORE_VERSION < QT_VERSION_CHECK(6, 30, 0)
-                errmess = KCalUtils::Stringify::errorMessage(*format->exception());
-#else
-                errmess = format->exception()->errorMessage();
-#endif
-            } else {
-                errmess = i18nc("@info save failure cause unknown", "Reason unknown");
+
+        // The window stays responsive while the calendar is written
+        auto exporter = new ICalExporter(mCalendar, filename, this);
+        connect(exporter, &ICalExporter::finished, this, [this, exporter, filename](bool success) {
+            if (success) {
+                KSharedConfig::openConfig()->group(QStringLiteral("Settings")).writeEntry("LastExportLocation", filename);
+            } else if (!exporter->errorString().isEmpty()) {
+                KMessageBox::error(this,
+                                   xi18nc("@info",
+                                          "Cannot write iCalendar file <filename>%1</filename>: <message>%2</message>",
+                                          filename,
+                                          exporter->errorString()));
             }
-            KMessageBox::error(this, xi18nc("@info", "Cannot write iCalendar file <filename>%1</filename>: <message>%2</message>", filename, errmess));
-        } else {
-            group.writeEntry("LastExportLocation", filename);
-        }
+            exporter->deleteLater();
+        });
+        exporter->start();
     }
 }
 
@@ -2522,7 +2526,7 @@ void CalendarView::purgeCompleted()
                                                           KGuiItem(i18nc("@action:button", "Purge"), QIcon::fromTheme(QStringLiteral("entry-delete"))));
 
     if (result == KMessageBox::Continue) {
-        mTodoPurger->purgeCompletedTodos();
+        todoPurger()->purgeCompletedTodos();
     }
 }
 
@@ -2664,30 +2668,24 @@ void CalendarView::showSideBar(bool show)
     }
 }
 
-static auto forCollection(const Akonadi::Collection &collection)
-{
-    return [collection](const Akonadi::CollectionCalendar::Ptr &calendar) {
-        return calendar->collection() == collection;
-    };
-}
-
 void CalendarView::collectionSelected(const Akonadi::Collection &collection)
 {
     if (!collection.isValid()) {
         return;
     }
 
-    // NOLINTBEGIN(modernize-use-ranges) to avoid detaching
-    auto enabledCalendar = std::find_if(mEnabledCalendars.cbegin(), mEnabledCalendars.cend(), forCollection(collection));
-    // NOLINTEND(modernize-use-ranges)
-    if (enabledCalendar != mEnabledCalendars.cend()) {
+    if (mEnabledCalendarsById.contains(collection.id())) {
         return;
     }
 
     const auto newCalendar = calendarForCollection(collection);
     mEnabledCalendars.push_back(newCalendar);
-    mDateNavigatorContainer->addCalendar(newCalendar);
-    Q_EMIT calendarAdded(newCalendar);
+    mEnabledCalendarsById.insert(collection.id(), newCalendar);
+    // Deselected and selected again before anybody was told
+    if (!mRemovedCalendars.removeOne(newCalendar)) {
+        mAddedCalendars.push_back(newCalendar);
+    }
+    scheduleCalendarChanges();
 }
 
 void CalendarView::collectionDeselected(const Akonadi::Collection &collection)
@@ -2696,18 +2694,56 @@ void CalendarView::collectionDeselected(const Akonadi::Collection &collection)
         return;
     }
 
-    // NOLINTBEGIN(modernize-use-ranges) to avoid detaching
-    auto calendarIt = std::find_if(mEnabledCalendars.cbegin(), mEnabledCalendars.cend(), forCollection(collection));
-    // NOLINTEND(modernize-use-ranges)
-    if (calendarIt == mEnabledCalendars.cend()) {
+    const auto deselectCalendar = mEnabledCalendarsById.take(collection.id());
+    if (!deselectCalendar) {
         return;
     }
 
-    const auto &deselectCalendar = *calendarIt;
     deselectCalendar->setFilter(nullptr);
     mEnabledCalendars.removeOne(deselectCalendar);
-    mDateNavigatorContainer->removeCalendar(deselectCalendar);
-    Q_EMIT calendarRemoved(deselectCalendar);
+    if (!mAddedCalendars.removeOne(deselectCalendar)) {
+        mRemovedCalendars.push_back(deselectCalendar);
+    }
+    scheduleCalendarChanges();
+}
+
+void CalendarView::beginCalendarChanges()
+{
+    ++mCalendarChangesDepth;
+}
+
+void CalendarView::commitCalendarChanges()
+{
+    Q_ASSERT(mCalendarChangesDepth > 0);
+    if (--mCalendarChangesDepth == 0) {
+        announceCalendarChanges();
+    }
+}
+
+void CalendarView::scheduleCalendarChanges()
+{
+    if (mCalendarChangesDepth > 0 || mCalendarChangesScheduled) {
+        return;
+    }
+    mCalendarChangesScheduled = true;
+    QTimer::singleShot(0, this, [this]() {
+        mCalendarChangesScheduled = false;
+        if (mCalendarChangesDepth == 0) {
+            announceCalendarChanges();
+        }
+    });
+}
+
+void CalendarView::announceCalendarChanges()
+{
+    const auto added = std::exchange(mAddedCalendars, {});
+    const auto removed = std::exchange(mRemovedCalendars, {});
+    if (added.isEmpty() && removed.isEmpty()) {
+        return;
+    }
+
+    mDateNavigatorContainer->changeCalendars(added, removed);
+    Q_EMIT calendarsChanged(added, removed);
 }
 
 Akonadi::Collection CalendarView::defaultCollection(const QLatin1StringView &mimeType) const
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include "incidencetransfer.h"
 #include "korganizerprivate_export.h"
+#include "occurrencecache.h"
 
 #include "interfaces/korganizer/calendarviewbase.h"
 
@@ -26,8 +28,9 @@
 
 #include <KAboutData>
 
+#include <QHash>
+
 #include <functional>
-#include <list>
 
 class DateChecker;
 class DateNavigator;
@@ -37,6 +40,8 @@ class KOTodoView;
 class KOViewManager;
 class NavigatorBar;
 class AkonadiCollectionView;
+class SearchIndex;
+class SearchIndexer;
 
 namespace CalendarSupport
 {
@@ -121,6 +126,12 @@ public:
 
     QList<Akonadi::CollectionCalendar::Ptr> &enabledCalendars();
 
+    /**
+     * Returns the enabled calendar of the collection with id @p collectionId,
+     * or a null pointer if that collection is not enabled.
+     */
+    [[nodiscard]] Akonadi::CollectionCalendar::Ptr enabledCalendar(Akonadi::Collection::Id collectionId) const;
+
     Akonadi::CollectionCalendar::Ptr calendarForCollection(const Akonadi::Collection &collection) override;
 
     void showMessage(const QString &message, KMessageWidget::MessageType);
@@ -157,6 +168,20 @@ public:
         return mChanger;
     }
 
+    /**
+      Returns the indexer of the search dialog, creating it on first use.
+    */
+    SearchIndexer *searchIndexer();
+
+    /**
+      Returns the occurrences of recurring incidences expanded so far.
+      It is shared by all widgets showing the calendars of this view.
+    */
+    OccurrenceCache *occurrenceCache()
+    {
+        return &mOccurrenceCache;
+    }
+
     /**
      * Informs the date navigator which incidence types should be used
      * to embolden days, this function is mainly called when the view changes
@@ -245,8 +270,11 @@ Q_SIGNALS:
     void filtersUpdated(const QStringList &, int);
     void filterChanged();
 
-    void calendarAdded(const Akonadi::CollectionCalendar::Ptr &);
-    void calendarRemoved(const Akonadi::CollectionCalendar::Ptr &);
+    /**
+      Emitted once for each batch of calendar selection changes, with the
+      calendars which were enabled and those which were disabled.
+    */
+    void calendarsChanged(const QList<Akonadi::CollectionCalendar::Ptr> &added, const QList<Akonadi::CollectionCalendar::Ptr> &removed);
 
 public Q_SLOTS:
     /** options dialog made a changed to the configuration. we catch this
@@ -593,6 +621,15 @@ public Q_SLOTS:
     void collectionSelected(const Akonadi::Collection &collection);
     void collectionDeselected(const Akonadi::Collection &collection);
 
+    /**
+      Collects the calendars selected and deselected until the matching
+      commitCalendarChanges(), and announces them with a single
+      calendarsChanged(). Batches may nest. Changes made outside a batch
+      are announced together once control returns to the event loop.
+    */
+    void beginCalendarChanges();
+    void commitCalendarChanges();
+
     void leftSplitterMoved(int, int);
 
     /** Popup the "What's New" dialog **/
@@ -629,6 +666,12 @@ public:
 
     static void toggleCompleted(const KCalendarCore::Todo::Ptr &, const QDate &);
 
+    /**
+      Creates the calendar filter called @p name as stored in @p config by
+      writeFilterSettings(). The caller owns the filter.
+    */
+    [[nodiscard]] static KCalendarCore::CalFilter *readFilter(const KConfig *config, const QString &name);
+
 protected:
     int msgItemDelete(const Akonadi::Item &item);
 
@@ -672,6 +715,12 @@ private:
 
     void dissociateOccurrence(const Akonadi::Item &item, const QDateTime &recurrenceId, bool thisAndFuture);
 
+    /**
+     * Copies or moves @p item to @p col. If the item is selected in the
+     * current view, all selected items are transferred.
+     */
+    void transferIncidences(IncidenceTransfer::Mode mode, const Akonadi::Item &item, const Akonadi::Collection &col);
+
     /**
      * Returns the default collection.
      * The view's collection takes precedence, only then the config one is used.
@@ -699,6 +748,16 @@ private:
      */
     void forEachCalendar(std::function<void(Akonadi::CollectionCalendar::Ptr)> func);
 
+    /** Creates the ITIP handler on first use. */
+    Akonadi::ITIPHandler *itipHandler();
+    /** Creates the to-do purger on first use. */
+    Akonadi::TodoPurger *todoPurger();
+    /** Gives the free/busy manager the calendar, unless it has it already. */
+    void setupFreeBusyManager();
+    static void registerCollectionPropertyPages();
+    void scheduleCalendarChanges();
+    void announceCalendarChanges();
+
     CalendarSupport::CalPrinter *mCalPrinter = nullptr;
     Akonadi::TodoPurger *mTodoPurger = nullptr;
 
@@ -720,11 +779,16 @@ private:
 
     Akonadi::ETMCalendar::Ptr mCalendar;
     QList<Akonadi::CollectionCalendar::Ptr> mEnabledCalendars;
-    // Actual linked-list implementation - we don't expect to ever have that many calendars
-    // enabled that e.g. QMap/QHash would be substantially faster over looping over the list.
-    // The advantage of the list is that on each iteration we can quickly remove and stale
-    // weak pointers.
-    std::list<QWeakPointer<Akonadi::CollectionCalendar>> mCalendars;
+    // Same calendars as mEnabledCalendars, for constant time lookups by collection
+    QHash<Akonadi::Collection::Id, Akonadi::CollectionCalendar::Ptr> mEnabledCalendarsById;
+    // Calendar selection changes not announced yet, see beginCalendarChanges()
+    QList<Akonadi::CollectionCalendar::Ptr> mAddedCalendars;
+    QList<Akonadi::CollectionCalendar::Ptr> mRemovedCalendars;
+    int mCalendarChangesDepth = 0;
+    bool mCalendarChangesScheduled = false;
+    // All calendars handed out by calendarForCollection(). Stale weak pointers are
+    // removed while iterating in forEachCalendar().
+    QHash<Akonadi::Collection::Id, QWeakPointer<Akonadi::CollectionCalendar>> mCalendars;
 
     DateNavigator *mDateNavigator = nullptr;
     DateChecker *mDateChecker = nullptr;
@@ -749,11 +813,15 @@ private:
     KOTodoView *mTodoList = nullptr;
     Akonadi::IncidenceChanger *mChanger = nullptr;
     Akonadi::ITIPHandler *mITIPHandler = nullptr;
+    bool mFreeBusyManagerReady = false;
     QList<int> mMainSplitterSizes; // temp store for main splitter sizes while left frame is hidden
     bool mSplitterSizesValid;
 
     Akonadi::CalendarClipboard *mCalendarClipboard = nullptr;
     AkonadiCollectionView *mETMCollectionView = nullptr;
+    SearchIndex *mSearchIndex = nullptr;
+    SearchIndexer *mSearchIndexer = nullptr;
+    OccurrenceCache mOccurrenceCache;
 
     Akonadi::SearchCollectionHelper mSearchCollectionHelper;
     QList<KAboutRelease> mReleasesInfo;
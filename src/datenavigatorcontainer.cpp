@@ -36,6 +36,7 @@ DateNavigatorContainer::DateNavigatorContainer(QWidget *parent)
              "Press it to select the whole week.</p>"
              "</qt>"));
 
+    mNavigatorView->setDayOccupancy(&mDayOccupancy);
     connectNavigatorView(mNavigatorView);
 }
 
@@ -76,26 +77,14 @@ void DateNavigatorContainer::connectNavigatorView(KDateNavigator *v)
     connect(v, &KDateNavigator::yearSelected, this, &DateNavigatorContainer::yearSelected);
 }
 
-void DateNavigatorContainer::addCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
+void DateNavigatorContainer::changeCalendars(const QList<Akonadi::CollectionCalendar::Ptr> &added, const QList<Akonadi::CollectionCalendar::Ptr> &removed)
 {
-    mNavigatorView->addCalendar(calendar);
-    for (KDateNavigator *n : std::as_const(mExtraViews)) {
-        if (n) {
-            n->addCalendar(calendar);
-        }
-    }
-    mCalendars.push_back(calendar);
+    mDayOccupancy.changeCalendars(added, removed);
 }
 
-void DateNavigatorContainer::removeCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
+void DateNavigatorContainer::setOccurrenceCache(OccurrenceCache *cache)
 {
-    mNavigatorView->removeCalendar(calendar);
-    for (KDateNavigator *n : std::as_const(mExtraViews)) {
-        if (n) {
-            n->removeCalendar(calendar);
-        }
-    }
-    mCalendars.removeOne(calendar);
+    mDayOccupancy.setOccurrenceCache(cache);
 }
 
 // TODO_Recurrence: let the navigators update just once, and tell them that
@@ -143,6 +132,8 @@ void DateNavigatorContainer::updateView()
 
 void DateNavigatorContainer::updateConfig()
 {
+    // The highlighted recurrences depend on the preferences
+    mDayOccupancy.setUpdateNeeded();
     mNavigatorView->updateConfig();
     for (KDateNavigator *n : std::as_const(mExtraViews)) {
         if (n) {
@@ -237,9 +228,7 @@ void DateNavigatorContainer::resizeAllContents()
         while (count > (mExtraViews.count() + 1)) {
             auto n = new KDateNavigator(this);
             mExtraViews.append(n);
-            for (const auto &calendar : std::as_const(mCalendars)) {
-                n->addCalendar(calendar);
-            }
+            n->setDayOccupancy(&mDayOccupancy);
             connectNavigatorView(n);
         }
 
@@ -302,15 +291,9 @@ QSize DateNavigatorContainer::sizeHint() const
     return mNavigatorView->sizeHint();
 }
 
-void DateNavigatorContainer::setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals) const
+void DateNavigatorContainer::setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals)
 {
-    mNavigatorView->setHighlightMode(highlightEvents, highlightTodos, highlightJournals);
-
-    for (const KDateNavigator *n : std::as_const(mExtraViews)) {
-        if (n) {
-            n->setHighlightMode(highlightEvents, highlightTodos, highlightJournals);
-        }
-    }
+    mDayOccupancy.setHighlightMode(highlightEvents, highlightTodos, highlightJournals);
 }
 
 void DateNavigatorContainer::goNextMonth()
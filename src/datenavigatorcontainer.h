@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include "dayoccupancy.h"
+
 #include <Akonadi/CollectionCalendar>
 
 #include <QDate>
@@ -20,6 +22,7 @@
 #include <QList>
 
 class KDateNavigator;
+class OccurrenceCache;
 
 class DateNavigatorContainer : public QFrame
 {
@@ -29,14 +32,20 @@ public:
     ~DateNavigatorContainer() override;
 
     /**
-      Associate date navigator with a calendar. It is used by KODayMatrix.
+      Associate date navigator with the @p added calendars and dissociate it
+      from the @p removed ones. Their incidences are highlighted once for all
+      navigators.
+    */
+    void changeCalendars(const QList<Akonadi::CollectionCalendar::Ptr> &added, const QList<Akonadi::CollectionCalendar::Ptr> &removed);
+
+    /**
+      Lets all navigators share the recurrence expansions of @p cache.
     */
-    void addCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
-    void removeCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
+    void setOccurrenceCache(OccurrenceCache *cache);
 
     QSize minimumSizeHint() const override;
     QSize sizeHint() const override;
-    void setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals) const;
+    void setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals);
     void setUpdateNeeded();
 
     /**
@@ -144,9 +153,10 @@ private:
      */
     KDateNavigator *firstNavigatorForDate(const QDate &date) const;
 
-    KDateNavigator *const mNavigatorView;
+    /** the days with incidences, shared by all navigators */
+    DayOccupancy mDayOccupancy;
 
-    QList<Akonadi::CollectionCalendar::Ptr> mCalendars;
+    KDateNavigator *const mNavigatorView;
 
     QList<KDateNavigator *> mExtraViews;
 
@@ -0,0 +1,358 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "dayoccupancy.h"
+#include "occurrencecache.h"
+#include "prefs/koprefs.h"
+
+#include <KCalendarCore/CalFilter>
+#include <KCalendarCore/Event>
+#include <KCalendarCore/Journal>
+#include <KCalendarCore/Todo>
+
+#include <algorithm>
+
+DayOccupancy::DayOccupancy(QObject *parent)
+    : QObject(parent)
+{
+}
+
+DayOccupancy::~DayOccupancy()
+{
+    for (const auto &calendar : std::as_const(mCalendars)) {
+        calendar->unregisterObserver(this);
+    }
+}
+
+void DayOccupancy::changeCalendars(const QList<Akonadi::CollectionCalendar::Ptr> &added, const QList<Akonadi::CollectionCalendar::Ptr> &removed)
+{
+    for (const auto &calendar : removed) {
+        calendar->unregisterObserver(this);
+        mCalendars.removeOne(calendar);
+        mJournalIndexes.remove(calendar.data());
+    }
+    for (const auto &calendar : added) {
+        calendar->registerObserver(this);
+        mCalendars.push_back(calendar);
+        mJournalIndexes.insert(calendar.data(), JournalIndex::forCalendar(calendar));
+    }
+
+    mPendingChanges = true;
+    Q_EMIT changed();
+}
+
+bool DayOccupancy::hasCalendars() const
+{
+    return !mCalendars.isEmpty();
+}
+
+void DayOccupancy::setOccurrenceCache(OccurrenceCache *cache)
+{
+    mOccurrenceCache = cache;
+}
+
+void DayOccupancy::setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals)
+{
+    if (highlightTodos != mHighlightTodos || highlightEvents != mHighlightEvents || highlightJournals != mHighlightJournals) {
+        mHighlightEvents = highlightEvents;
+        mHighlightTodos = highlightTodos;
+        mHighlightJournals = highlightJournals;
+        mPendingChanges = true;
+        Q_EMIT changed();
+    }
+}
+
+void DayOccupancy::setRange(const void *client, QDate first, QDate last)
+{
+    const std::pair<QDate, QDate> range(first, last);
+    auto it = mRanges.find(client);
+    if (it != mRanges.end() && it.value() == range) {
+        return;
+    }
+    mRanges.insert(client, range);
+    mPendingChanges = true;
+}
+
+void DayOccupancy::removeRange(const void *client)
+{
+    if (mRanges.remove(client)) {
+        mPendingChanges = true;
+    }
+}
+
+bool DayOccupancy::isOccupied(QDate date)
+{
+    if (mPendingChanges) {
+        rebuild();
+    }
+    if (!mFirst.isValid() || date < mFirst || date > mLast) {
+        return false;
+    }
+    return mDayRefCount.at(mFirst.daysTo(date)) > 0;
+}
+
+quint64 DayOccupancy::revision()
+{
+    if (mPendingChanges) {
+        rebuild();
+    }
+    return mRevision;
+}
+
+void DayOccupancy::setUpdateNeeded()
+{
+    mPendingChanges = true;
+}
+
+void DayOccupancy::rebuild()
+{
+    mFirst = {};
+    mLast = {};
+    for (const auto &[first, last] : std::as_const(mRanges)) {
+        if (first.isValid() && last.isValid()) {
+            mFirst = mFirst.isValid() ? std::min(mFirst, first) : first;
+            mLast = mLast.isValid() ? std::max(mLast, last) : last;
+        }
+    }
+
+    mIncidenceDays.clear();
+    mDayRefCount.clear();
+    if (mFirst.isValid()) {
+        mDayRefCount.resize(mFirst.daysTo(mLast) + 1);
+
+        if (mHighlightEvents) {
+            updateEvents();
+        }
+
+        if (mHighlightTodos) {
+            updateTodos();
+        }
+
+        if (mHighlightJournals) {
+            updateJournals();
+        }
+    }
+
+    mPendingChanges = false;
+    ++mRevision;
+}
+
+void DayOccupancy::updateJournals()
+{
+    // The index buckets journals in the time zone of the calendar, so query a
+    // day more on both sides; incidenceDays() clips to the range anyway
+    const QDate first = mFirst.addDays(-1);
+    const QDate last = mLast.addDays(1);
+    for (const JournalIndex::Ptr &journalIndex : std::as_const(mJournalIndexes)) {
+        const KCalendarCore::Journal::List journals = journalIndex->journals(first, last);
+        for (const KCalendarCore::Journal::Ptr &journal : journals) {
+            Q_ASSERT(journal);
+            addIncidenceDays(journal);
+        }
+    }
+}
+
+void DayOccupancy::updateTodos()
+{
+    for (const auto &calendar : std::as_const(mCalendars)) {
+        const KCalendarCore::Todo::List todos = calendar->todos();
+        for (const KCalendarCore::Todo::Ptr &t : todos) {
+            Q_ASSERT(t);
+            addIncidenceDays(t);
+        }
+    }
+}
+
+void DayOccupancy::updateEvents()
+{
+    for (const auto &calendar : std::as_const(mCalendars)) {
+        const auto eventlist = calendar->events(mFirst, mLast, calendar->timeZone());
+        for (const KCalendarCore::Event::Ptr &ev : eventlist) {
+            Q_ASSERT(ev);
+            addIncidenceDays(ev);
+        }
+    }
+}
+
+void DayOccupancy::addDays(QBitArray &days, QDate first, QDate last) const
+{
+    if (!first.isValid() || !last.isValid()) {
+        return;
+    }
+    const qint64 firstIndex = std::max<qint64>(mFirst.daysTo(first), 0);
+    const qint64 lastIndex = std::min<qint64>(mFirst.daysTo(last), days.size() - 1);
+    if (firstIndex <= lastIndex) {
+        days.fill(true, firstIndex, lastIndex + 1);
+    }
+}
+
+QBitArray DayOccupancy::incidenceDays(const KCalendarCore::Incidence::Ptr &incidence) const
+{
+    const ushort recurType = incidence->recurrenceType();
+    const bool recurrenceHighlighted = !(recurType == KCalendarCore::Recurrence::rDaily && !KOPrefs::instance()->mDailyRecur)
+        && !(recurType == KCalendarCore::Recurrence::rWeekly && !KOPrefs::instance()->mWeeklyRecur);
+    const QDateTime rangeEnd(mLast, QTime(23, 59, 59), QTimeZone::LocalTime);
+    QBitArray days(mDayRefCount.size());
+
+    switch (incidence->type()) {
+    case KCalendarCore::Incidence::TypeEvent: {
+        if (!mHighlightEvents || !recurrenceHighlighted) {
+            break;
+        }
+        const KCalendarCore::Event::Ptr ev = incidence.staticCast<KCalendarCore::Event>();
+        const QDateTime dtStart = ev->dtStart().toLocalTime();
+
+        // timed incidences occur in
+        //   [dtStart(), dtEnd()[. All-day incidences occur in [dtStart(), dtEnd()]
+        // so we subtract 1 second in the timed case
+        const int secsToAdd = ev->allDay() ? 0 : -1;
+        const QDateTime dtEnd = ev->dtEnd().toLocalTime().addSecs(secsToAdd);
+
+        if (ev->recurs()) {
+            // Its a recurring event, find out in which days it occurs. Occurrences
+            // starting before the range can still reach into it.
+            const int eventDuration = dtStart.daysTo(dtEnd);
+            const auto timeDateList = occurrences(ev, QDateTime(mFirst.addDays(-eventDuration), {}, QTimeZone::LocalTime), rangeEnd);
+            for (const QDateTime &t : timeDateList) {
+                const QDate d = t.toLocalTime().date();
+                addDays(days, d, d.addDays(eventDuration));
+            }
+        } else {
+            addDays(days, dtStart.date(), dtEnd.date());
+        }
+        break;
+    }
+    case KCalendarCore::Incidence::TypeTodo: {
+        const KCalendarCore::Todo::Ptr t = incidence.staticCast<KCalendarCore::Todo>();
+        if (!mHighlightTodos || !t->hasDueDate()) {
+            break;
+        }
+        if (t->recurs() && recurrenceHighlighted) {
+            // It's a recurring todo, find out in which days it occurs
+            const auto timeDateList = occurrences(t, QDateTime(mFirst, {}, QTimeZone::LocalTime), rangeEnd);
+            for (const QDateTime &dt : timeDateList) {
+                const QDate d = dt.toLocalTime().date();
+                addDays(days, d, d);
+            }
+        } else {
+            const QDate d = t->dtDue().toLocalTime().date();
+            addDays(days, d, d);
+        }
+        break;
+    }
+    case KCalendarCore::Incidence::TypeJournal: {
+        if (!mHighlightJournals) {
+            break;
+        }
+        const QDate d = incidence->dtStart().toLocalTime().date();
+        addDays(days, d, d);
+        break;
+    }
+    default:
+        break;
+    }
+
+    return days;
+}
+
+QList<QDateTime> DayOccupancy::occurrences(const KCalendarCore::Incidence::Ptr &incidence, const QDateTime &start, const QDateTime &end) const
+{
+    if (mOccurrenceCache) {
+        return mOccurrenceCache->timesInInterval(incidence, start, end);
+    }
+    return incidence->recurrence()->timesInInterval(start, end);
+}
+
+bool DayOccupancy::isFilteredOut(const KCalendarCore::Incidence::Ptr &incidence) const
+{
+    for (const auto &calendar : std::as_const(mCalendars)) {
+        if (calendar->incidence(incidence->uid(), incidence->recurrenceId()) == incidence) {
+            const KCalendarCore::CalFilter *filter = calendar->filter();
+            return filter && !filter->filterIncidence(incidence);
+        }
+    }
+    return false;
+}
+
+bool DayOccupancy::addIncidenceDays(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    const QBitArray days = incidenceDays(incidence);
+    if (days.count(true) == 0) {
+        return false;
+    }
+
+    mIncidenceDays.insert(incidence.data(), days);
+    bool changed = false;
+    for (qsizetype i = 0; i < days.size(); ++i) {
+        if (days.testBit(i) && mDayRefCount[i]++ == 0) {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool DayOccupancy::removeIncidenceDays(const KCalendarCore::Incidence *incidence)
+{
+    const QBitArray days = mIncidenceDays.take(incidence);
+    bool changed = false;
+    for (qsizetype i = 0; i < days.size(); ++i) {
+        if (days.testBit(i) && --mDayRefCount[i] == 0) {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void DayOccupancy::updateIncidenceDays(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    // Observers are notified in no particular order, so the shared cache may
+    // not have heard about the change yet
+    if (mOccurrenceCache) {
+        mOccurrenceCache->invalidate(incidence);
+    }
+
+    // A full rebuild will pick up the change anyway
+    if (mPendingChanges || !mFirst.isValid()) {
+        return;
+    }
+
+    // The full rebuild only sees what the calendar filter lets through
+    bool changed = removeIncidenceDays(incidence.data());
+    if (!isFilteredOut(incidence)) {
+        changed |= addIncidenceDays(incidence);
+    }
+    if (changed) {
+        ++mRevision;
+        Q_EMIT this->changed();
+    }
+}
+
+void DayOccupancy::calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    updateIncidenceDays(incidence);
+}
+
+void DayOccupancy::calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    updateIncidenceDays(incidence);
+}
+
+void DayOccupancy::calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar)
+{
+    Q_UNUSED(calendar)
+    if (mPendingChanges || !mFirst.isValid()) {
+        return;
+    }
+
+    if (removeIncidenceDays(incidence.data())) {
+        ++mRevision;
+        Q_EMIT changed();
+    }
+}
+
+#include "moc_dayoccupancy.cpp"
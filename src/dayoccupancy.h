@@ -0,0 +1,161 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "journalindex.h"
+#include "korganizerprivate_export.h"
+
+#include <Akonadi/CollectionCalendar>
+
+#include <QBitArray>
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QObject>
+
+class OccurrenceCache;
+
+/**
+  Knows which days have highlighted incidences, for all date navigators.
+
+  Each KODayMatrix registers the days it shows with setRange(). The
+  occupancy covers the union of these ranges with a single pass over the
+  calendars, and each matrix reads its own days from it. Adjacent months
+  overlapping by up to two weeks are therefore computed once, and showing a
+  year of navigators costs no more than one pass.
+
+  The full pass is done lazily on the first query after the calendars, the
+  ranges or the preferences changed. Single incidence changes only update
+  the days of that incidence.
+
+  @short Shared day occupancy of the date navigators
+*/
+class KORGANIZERPRIVATE_EXPORT DayOccupancy : public QObject, public KCalendarCore::Calendar::CalendarObserver
+{
+    Q_OBJECT
+public:
+    explicit DayOccupancy(QObject *parent = nullptr);
+    ~DayOccupancy() override;
+
+    /**
+      Observes the @p added calendars and stops observing the @p removed ones.
+    */
+    void changeCalendars(const QList<Akonadi::CollectionCalendar::Ptr> &added, const QList<Akonadi::CollectionCalendar::Ptr> &removed);
+    [[nodiscard]] bool hasCalendars() const;
+
+    /**
+      Expand recurrences through @p cache, which is shared with the other
+      widgets showing the same calendars. Without a cache every recurrence
+      is expanded here.
+    */
+    void setOccurrenceCache(OccurrenceCache *cache);
+
+    /** Sets which incidences should be highlighted */
+    void setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals);
+
+    /**
+      Sets the days from @p first to @p last shown by @p client. The
+      occupancy covers the ranges of all clients.
+    */
+    void setRange(const void *client, QDate first, QDate last);
+    void removeRange(const void *client);
+
+    /**
+      Returns whether @p date has at least one highlighted incidence. Days
+      outside of all ranges have none.
+    */
+    [[nodiscard]] bool isOccupied(QDate date);
+
+    /**
+      Returns a number which changes whenever any day may have become
+      occupied or free, so that clients can cache what they derived from
+      isOccupied(). Rebuilds the occupancy if needed.
+    */
+    [[nodiscard]] quint64 revision();
+
+    /** Rebuilds the occupancy from scratch on the next query. */
+    void setUpdateNeeded();
+
+    /**
+      Reimplemented from KCalendarCore::Calendar::CalendarObserver.
+      They only update the days covered by the given incidence, unless a
+      full rebuild is already pending.
+    */
+    void calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar) override;
+
+Q_SIGNALS:
+    /** Emitted when days may have to be drawn differently. */
+    void changed();
+
+private:
+    void rebuild();
+
+    /** adds all days that have events to the occupancy data */
+    void updateEvents();
+
+    /** adds all days that have to-dos with due date to the occupancy data */
+    void updateTodos();
+
+    /** adds all days that have journals to the occupancy data */
+    void updateJournals();
+
+    /** returns the days covered by @p incidence, empty if it is not highlighted. */
+    [[nodiscard]] QBitArray incidenceDays(const KCalendarCore::Incidence::Ptr &incidence) const;
+
+    /** returns the occurrences of the recurring @p incidence between @p start and @p end. */
+    [[nodiscard]] QList<QDateTime> occurrences(const KCalendarCore::Incidence::Ptr &incidence, const QDateTime &start, const QDateTime &end) const;
+
+    /** marks the covered days between @p first and @p last in @p days. */
+    void addDays(QBitArray &days, QDate first, QDate last) const;
+
+    /** returns whether the filter of the calendar holding @p incidence hides it. */
+    [[nodiscard]] bool isFilteredOut(const KCalendarCore::Incidence::Ptr &incidence) const;
+
+    /** records the contribution of @p incidence. Returns true if a day changed. */
+    bool addIncidenceDays(const KCalendarCore::Incidence::Ptr &incidence);
+
+    /** forgets the contribution of @p incidence. Returns true if a day changed. */
+    bool removeIncidenceDays(const KCalendarCore::Incidence *incidence);
+
+    /** recomputes the contribution of a single added or changed incidence. */
+    void updateIncidenceDays(const KCalendarCore::Incidence::Ptr &incidence);
+
+    QList<Akonadi::CollectionCalendar::Ptr> mCalendars;
+
+    /** journals of each calendar, sorted by date */
+    QHash<const Akonadi::CollectionCalendar *, JournalIndex::Ptr> mJournalIndexes;
+
+    /** shared expansions of recurring incidences, may be null */
+    OccurrenceCache *mOccurrenceCache = nullptr;
+
+    /** the days shown by each client */
+    QHash<const void *, std::pair<QDate, QDate>> mRanges;
+
+    /** the days covered, the union of mRanges as of the last rebuild */
+    QDate mFirst;
+    QDate mLast;
+
+    /** days covered by each highlighted incidence, one bit per covered day. */
+    QHash<const KCalendarCore::Incidence *, QBitArray> mIncidenceDays;
+
+    /** number of highlighted incidences on each covered day. */
+    QList<int> mDayRefCount;
+
+    /** incremented by every rebuild and every change of a day */
+    quint64 mRevision = 0;
+
+    /** the occupancy must be rebuilt before the next query */
+    bool mPendingChanges = true;
+
+    bool mHighlightEvents = true;
+    bool mHighlightTodos = false;
+    bool mHighlightJournals = false;
+};
@@ -11,11 +11,17 @@
 #include "searchdialog.h"
 
 #include "calendarview.h"
+#include "journalindex.h"
 #include "koeventpopupmenu.h"
 #include "korganizer_debug.h"
+#include "searchengine.h"
+#include "searchindex.h"
+#include "searchindexer.h"
 #include "ui_searchdialog_base.h"
 
+#include <Akonadi/CalendarUtils>
 #include <EventViews/ListView>
+#include <KCalendarCore/CalFilter>
 #include <PimCommon/PimUtil>
 
 #include <KConfigGroup>
@@ -30,12 +36,17 @@
 namespace
 {
 const char mySearchDialogConfigGroupName[] = "SearchDialog";
+// Delay before the first refresh of the result list while a search is running;
+// it doubles after each refresh
+constexpr int listViewUpdateInterval = 200;
+
 }
 
 SearchDialog::SearchDialog(CalendarView *calendarview)
     : QDialog(calendarview)
     , m_ui(new Ui::SearchDialog)
     , m_calendarview(calendarview)
+    , m_searchEngine(new SearchEngine(this))
 {
     setWindowTitle(i18nc("@title:window", "Find in Calendars"));
     setModal(false);
@@ -77,6 +88,20 @@ SearchDialog::SearchDialog(CalendarView *calendarview)
 
     connect(m_user1Button, &QPushButton::clicked, this, &SearchDialog::doSearch);
 
+    connect(m_searchEngine, &SearchEngine::matchesFound, this, &SearchDialog::slotMatchesFound);
+    connect(m_searchEngine, &SearchEngine::finished, this, &SearchDialog::slotSearchFinished);
+
+    // The list view can only show a whole new list, so it is rebuilt with
+    // all results so far. The delay between rebuilds doubles each time, so
+    // the total work is proportional to the number of results rather than
+    // to its square
+    m_listViewUpdateTimer.setSingleShot(true);
+    m_listViewUpdateTimer.setInterval(listViewUpdateInterval);
+    connect(&m_listViewUpdateTimer, &QTimer::timeout, this, [this]() {
+        m_listView->showIncidences(m_matchedEvents, QDate());
+        m_listViewUpdateTimer.setInterval(2 * m_listViewUpdateTimer.interval());
+    });
+
     // Propagate edit and delete event signals from event list view
     connect(m_listView, &EventViews::ListView::showIncidenceSignal, this, &SearchDialog::showIncidenceSignal);
     connect(m_listView, &EventViews::ListView::editIncidenceSignal, this, &SearchDialog::editIncidenceSignal);
@@ -99,6 +124,9 @@ SearchDialog::SearchDialog(CalendarView *calendarview)
         m_listView->addCalendar(calendar);
     }
 
+    // The index follows the calendar from now on
+    (void)m_calendarview->searchIndexer();
+
     readConfig();
 }
 
@@ -118,6 +146,9 @@ void SearchDialog::showEvent(QShowEvent *event)
 
 void SearchDialog::searchPatternChanged(const QString &pattern)
 {
+    // Results for the old pattern are not interesting anymore
+    m_searchEngine->cancel();
+    m_listViewUpdateTimer.stop();
     m_user1Button->setEnabled(!pattern.isEmpty());
 }
 
@@ -131,7 +162,7 @@ void SearchDialog::dateRangeCheckboxToggled()
     m_ui->includeUndatedTodos->setEnabled(m_ui->dateRangeCheckbox->isChecked());
 }
 
-void SearchDialog::doSearch()
+QRegularExpression SearchDialog::searchExpression() const
 {
     QRegularExpression re;
     re.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
@@ -140,6 +171,12 @@ void SearchDialog::doSearch()
     options |= QRegularExpression::NonPathWildcardConversion;
     const QString pattern = QRegularExpression::wildcardToRegularExpression(m_ui->searchEdit->text(), options);
     re.setPattern(pattern);
+    return re;
+}
+
+void SearchDialog::doSearch()
+{
+    const QRegularExpression re = searchExpression();
     if (!re.isValid()) {
         KMessageBox::error(this,
                            i18nc("@info",
@@ -150,15 +187,7 @@ void SearchDialog::doSearch()
     }
 
     search(re);
-    m_listView->showIncidences(m_matchedEvents, QDate());
-    updateMatchesText();
-    if (m_matchedEvents.isEmpty()) {
-        m_ui->numItems->setText(QString());
-        KMessageBox::information(this,
-                                 i18nc("@info", "No items were found that match your search pattern."),
-                                 i18nc("@title:window", "Search Results"),
-                                 QStringLiteral("NoSearchResults"));
-    }
+    m_notifyNoResults = true;
 }
 
 void SearchDialog::popupMenu(const QPoint &point)
@@ -171,23 +200,24 @@ void SearchDialog::updateMatchesText()
     if (m_matchedEvents.isEmpty()) {
         m_ui->numItems->setText(QString());
     } else {
-        m_ui->numItems->setText(i18ncp("@label", "%1 match", "%1 matches", m_matchedEvents.count()));
+        const qint64 hitsPerSecond = m_matchedEvents.count() * 1000 / std::max<qint64>(m_searchElapsed, 1);
+        m_ui->numItems->setText(i18ncp("@label", "%1 match (%2 per second)", "%1 matches (%2 per second)", m_matchedEvents.count(), hitsPerSecond));
     }
 }
 
 void SearchDialog::updateView()
 {
-    QRegularExpression re;
-    re.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-    re.setPattern(m_ui->searchEdit->text());
-    m_listView->clear();
+    const QRegularExpression re = searchExpression();
     if (re.isValid()) {
         search(re);
     } else {
+        m_searchEngine->cancel();
+        m_listViewUpdateTimer.stop();
         m_matchedEvents.clear();
+        m_listView->showIncidences(m_matchedEvents, QDate());
+        updateMatchesText();
     }
-    m_listView->showIncidences(m_matchedEvents, QDate());
-    updateMatchesText();
+    m_notifyNoResults = false;
 }
 
 void SearchDialog::search(const QRegularExpression &regularExpression)
@@ -195,11 +225,62 @@ void SearchDialog::search(const QRegularExpression &regularExpression)
     const QDate startDt = m_ui->startDate->date();
     const QDate endDt = m_ui->endDate->date();
 
-    KCalendarCore::Event::List events;
-    KCalendarCore::Todo::List todos;
-    KCalendarCore::Journal::List journals;
+    SearchEngine::SearchFields fields;
+    if (m_ui->summaryCheck->isChecked()) {
+        fields |= SearchEngine::Summary;
+    }
+    if (m_ui->descriptionCheck->isChecked()) {
+        fields |= SearchEngine::Description;
+    }
+    if (m_ui->categoryCheck->isChecked()) {
+        fields |= SearchEngine::Categories;
+    }
+    if (m_ui->locationCheck->isChecked()) {
+        fields |= SearchEngine::Location;
+    }
+    if (m_ui->attendeeCheck->isChecked()) {
+        fields |= SearchEngine::Attendees;
+    }
+
+    // The index narrows down the incidences to verify with the regular expression
+    SearchIndexer *searchIndexer = m_calendarview->searchIndexer();
+    const auto candidates = searchIndexer->index()->candidates(m_ui->searchEdit->text(), fields);
+
+    // Each candidate is only looked up in the calendar it was indexed in
+    QHash<Akonadi::Collection::Id, QList<Akonadi::Item::Id>> candidatesByCollection;
+    if (candidates) {
+        for (const Akonadi::Item::Id id : std::as_const(*candidates)) {
+            candidatesByCollection[searchIndexer->index()->collectionId(id)].append(id);
+        }
+    }
+
+    KCalendarCore::Incidence::List searchedIncidences;
+    m_searchedCollections.clear();
     const auto enabledCalendars = m_calendarview->enabledCalendars();
     for (const auto &calendar : enabledCalendars) {
+        const Akonadi::Collection::Id collectionId = calendar->collection().id();
+        // Calendars which are still loading are searched completely, the index doesn't know all of their items yet
+        const bool useCandidates = candidates && searchIndexer->isIndexed(collectionId);
+        const QList<Akonadi::Item::Id> calendarCandidates = candidatesByCollection.value(collectionId);
+
+        // Without a date range, the candidates only need to be of a searched type
+        // and pass the filter; the lists of all incidences are not needed
+        if (useCandidates && !m_ui->dateRangeCheckbox->isChecked()) {
+            const KCalendarCore::CalFilter *filter = m_ui->unfiltered->isChecked() ? nullptr : calendar->filter();
+            for (const Akonadi::Item::Id id : calendarCandidates) {
+                const KCalendarCore::Incidence::Ptr incidence = Akonadi::CalendarUtils::incidence(calendar->item(id));
+                if (!incidence || !isSearchedType(incidence) || (filter && !filter->filterIncidence(incidence))) {
+                    continue;
+                }
+                searchedIncidences.append(incidence);
+                m_searchedCollections.insert(incidence.data(), collectionId);
+            }
+            continue;
+        }
+
+        KCalendarCore::Event::List events;
+        KCalendarCore::Todo::List todos;
+        KCalendarCore::Journal::List journals;
         if (m_ui->dateRangeCheckbox->isChecked()) {
             if (m_ui->eventsCheck->isChecked()) {
                 if (m_ui->unfiltered->isChecked()) {
@@ -236,12 +317,11 @@ void SearchDialog::search(const QRegularExpression &regularExpression)
             }
 
             if (m_ui->journalsCheck->isChecked()) {
-                for (auto dt = startDt; dt <= endDt; dt = dt.addDays(1)) {
-                    if (m_ui->unfiltered->isChecked()) {
-                        journals += calendar->rawJournalsForDate(dt);
-                    } else {
-                        journals += calendar->journals(dt);
-                    }
+                const JournalIndex::Ptr journalIndex = JournalIndex::forCalendar(calendar);
+                if (m_ui->unfiltered->isChecked()) {
+                    journals += journalIndex->rawJournals(startDt, endDt);
+                } else {
+                    journals += journalIndex->journals(startDt, endDt);
                 }
             }
 
@@ -268,57 +348,86 @@ void SearchDialog::search(const QRegularExpression &regularExpression)
                 }
             }
         }
+
+        const KCalendarCore::Incidence::List calendarIncidences = Akonadi::ETMCalendar::mergeIncidenceList(events, todos, journals);
+
+        if (useCandidates) {
+            QSet<const KCalendarCore::Incidence *> candidateIncidences;
+            for (const Akonadi::Item::Id id : calendarCandidates) {
+                const KCalendarCore::Incidence::Ptr incidence = Akonadi::CalendarUtils::incidence(calendar->item(id));
+                if (incidence) {
+                    candidateIncidences.insert(incidence.data());
+                }
+            }
+            for (const KCalendarCore::Incidence::Ptr &incidence : calendarIncidences) {
+                if (candidateIncidences.contains(incidence.data())) {
+                    searchedIncidences.append(incidence);
+                    m_searchedCollections.insert(incidence.data(), collectionId);
+                }
+            }
+        } else {
+            for (const KCalendarCore::Incidence::Ptr &incidence : calendarIncidences) {
+                searchedIncidences.append(incidence);
+                m_searchedCollections.insert(incidence.data(), collectionId);
+            }
+        }
     }
 
     m_matchedEvents.clear();
-    const KCalendarCore::Incidence::List incidences = Akonadi::ETMCalendar::mergeIncidenceList(events, todos, journals);
+    m_listView->clear();
+    m_listViewUpdateTimer.stop();
+    m_listViewUpdateTimer.setInterval(listViewUpdateInterval);
+    m_searchElapsed = 0;
+    m_searchTimer.start();
+    m_searchEngine->start(searchedIncidences, regularExpression, fields);
+}
+
+bool SearchDialog::isSearchedType(const KCalendarCore::Incidence::Ptr &incidence) const
+{
+    switch (incidence->type()) {
+    case KCalendarCore::Incidence::TypeEvent:
+        return m_ui->eventsCheck->isChecked();
+    case KCalendarCore::Incidence::TypeTodo:
+        return m_ui->todosCheck->isChecked();
+    case KCalendarCore::Incidence::TypeJournal:
+        return m_ui->journalsCheck->isChecked();
+    default:
+        return false;
+    }
+}
+
+void SearchDialog::slotMatchesFound(const KCalendarCore::Incidence::List &incidences)
+{
     for (const KCalendarCore::Incidence::Ptr &ev : incidences) {
         Q_ASSERT(ev);
-        auto collectionId = ev->customProperty("VOLATILE", "COLLECTION-ID").toLongLong();
-        Akonadi::Item item;
-        const auto enabledCalendars2 = m_calendarview->enabledCalendars();
-        for (const auto &calendar : enabledCalendars2) {
-            if (calendar->collection().id() == collectionId) {
-                item = calendar->item(ev);
-            }
-        }
+        const auto calendar = m_calendarview->enabledCalendar(m_searchedCollections.value(ev.data(), -1));
+        const Akonadi::Item item = calendar ? calendar->item(ev) : Akonadi::Item();
         if (!item.isValid()) {
             qCWarning(KORGANIZER_LOG) << "Failed to translate incidence " << ev->uid() << " to Akonadi Item";
             continue;
         }
+        m_matchedEvents.append(item);
+    }
 
-        if (m_ui->summaryCheck->isChecked()) {
-            if (regularExpression.match(ev->summary()).hasMatch()) {
-                m_matchedEvents.append(item);
-                continue;
-            }
-        }
-        if (m_ui->descriptionCheck->isChecked()) {
-            if (regularExpression.match(ev->description()).hasMatch()) {
-                m_matchedEvents.append(item);
-                continue;
-            }
-        }
-        if (m_ui->categoryCheck->isChecked()) {
-            if (regularExpression.match(ev->categoriesStr()).hasMatch()) {
-                m_matchedEvents.append(item);
-                continue;
-            }
-        }
-        if (m_ui->locationCheck->isChecked()) {
-            if (regularExpression.match(ev->location()).hasMatch()) {
-                m_matchedEvents.append(item);
-                continue;
-            }
-        }
-        if (m_ui->attendeeCheck->isChecked()) {
-            const KCalendarCore::Attendee::List lstAttendees = ev->attendees();
-            if (std::ranges::any_of(lstAttendees, [regularExpression](const KCalendarCore::Attendee &attendee) {
-                    return regularExpression.match(attendee.fullName()).hasMatch();
-                })) {
-                m_matchedEvents.append(item);
-            }
-        }
+    m_searchElapsed = m_searchTimer.elapsed();
+    updateMatchesText();
+    if (!m_listViewUpdateTimer.isActive()) {
+        m_listViewUpdateTimer.start();
+    }
+}
+
+void SearchDialog::slotSearchFinished()
+{
+    m_searchElapsed = m_searchTimer.elapsed();
+    m_listViewUpdateTimer.stop();
+    m_listView->showIncidences(m_matchedEvents, QDate());
+    updateMatchesText();
+    const bool notifyNoResults = std::exchange(m_notifyNoResults, false);
+    if (m_matchedEvents.isEmpty() && notifyNoResults) {
+        KMessageBox::information(this,
+                                 i18nc("@info", "No items were found that match your search pattern."),
+                                 i18nc("@title:window", "Search Results"),
+                                 QStringLiteral("NoSearchResults"));
     }
 }
 
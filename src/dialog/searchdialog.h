@@ -10,13 +10,20 @@
 
 #pragma once
 
+#include <Akonadi/Collection>
 #include <Akonadi/Item>
 
+#include <KCalendarCore/Incidence>
+
 #include <QDialog>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTimer>
 
 class QPushButton;
 class CalendarView;
 class KOEventPopupMenu;
+class SearchEngine;
 
 namespace Ui
 {
@@ -28,11 +35,6 @@ namespace EventViews
 class ListView;
 }
 
-namespace KCalendarCore
-{
-class Incidence;
-}
-
 class SearchDialog : public QDialog
 {
     Q_OBJECT
@@ -57,9 +59,13 @@ protected:
     void showEvent(QShowEvent *event) override;
 
 private:
+    [[nodiscard]] QRegularExpression searchExpression() const;
+    [[nodiscard]] bool isSearchedType(const KCalendarCore::Incidence::Ptr &incidence) const;
     void doSearch();
     void searchPatternChanged(const QString &pattern);
     void search(const QRegularExpression &regularExpression);
+    void slotMatchesFound(const KCalendarCore::Incidence::List &incidences);
+    void slotSearchFinished();
     void readConfig();
     void writeConfig();
     void updateMatchesText();
@@ -68,6 +74,13 @@ private:
     CalendarView *const m_calendarview; // parent
     KOEventPopupMenu *m_popupMenu = nullptr;
     Akonadi::Item::List m_matchedEvents;
+    // Collection of each incidence handed to the search engine
+    QHash<const KCalendarCore::Incidence *, Akonadi::Collection::Id> m_searchedCollections;
     EventViews::ListView *m_listView = nullptr;
     QPushButton *m_user1Button = nullptr;
+    SearchEngine *const m_searchEngine;
+    QTimer m_listViewUpdateTimer;
+    QElapsedTimer m_searchTimer;
+    qint64 m_searchElapsed = 0;
+    bool m_notifyNoResults = false;
 };
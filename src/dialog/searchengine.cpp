@@ -0,0 +1,186 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "searchengine.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+// Number of incidences matched by a single task of the thread pool
+constexpr qsizetype chunkSize = 2000;
+
+struct SearchEntry {
+    QString summary;
+    QString description;
+    QString categories;
+    QString location;
+    QStringList attendees;
+};
+
+bool entryMatches(const SearchEntry &entry, const QRegularExpression &regularExpression, SearchEngine::SearchFields fields)
+{
+    if ((fields & SearchEngine::Summary) && regularExpression.match(entry.summary).hasMatch()) {
+        return true;
+    }
+    if ((fields & SearchEngine::Description) && regularExpression.match(entry.description).hasMatch()) {
+        return true;
+    }
+    if ((fields & SearchEngine::Categories) && regularExpression.match(entry.categories).hasMatch()) {
+        return true;
+    }
+    if ((fields & SearchEngine::Location) && regularExpression.match(entry.location).hasMatch()) {
+        return true;
+    }
+    if (fields & SearchEngine::Attendees) {
+        return std::ranges::any_of(entry.attendees, [&regularExpression](const QString &attendee) {
+            return regularExpression.match(attendee).hasMatch();
+        });
+    }
+    return false;
+}
+}
+
+struct SearchEngine::SearchState {
+    // Only accessed from the thread the engine lives in
+    KCalendarCore::Incidence::List incidences;
+    int pendingChunks = 0;
+
+    // Read-only snapshot shared with the workers
+    QList<SearchEntry> entries;
+    QRegularExpression regularExpression;
+    SearchFields fields;
+
+    std::atomic<bool> cancelled = false;
+};
+
+SearchEngine::SearchEngine(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SearchEngine::~SearchEngine()
+{
+    cancel();
+    // Workers post their results to this object, so they must not outlive it
+    mThreadPool.waitForDone();
+}
+
+void SearchEngine::start(const KCalendarCore::Incidence::List &incidences, const QRegularExpression &regularExpression, SearchFields fields)
+{
+    cancel();
+
+    auto state = std::make_shared<SearchState>();
+    state->incidences = incidences;
+    state->regularExpression = regularExpression;
+    state->regularExpression.optimize(); // compile once, before the workers share it
+    state->fields = fields;
+
+    state->entries.reserve(incidences.size());
+    for (const KCalendarCore::Incidence::Ptr &incidence : incidences) {
+        Q_ASSERT(incidence);
+        SearchEntry entry;
+        if (fields & Summary) {
+            entry.summary = incidence->summary();
+        }
+        if (fields & Description) {
+            entry.description = incidence->description();
+        }
+        if (fields & Categories) {
+            entry.categories = incidence->categoriesStr();
+        }
+        if (fields & Location) {
+            entry.location = incidence->location();
+        }
+        if (fields & Attendees) {
+            const KCalendarCore::Attendee::List attendees = incidence->attendees();
+            entry.attendees.reserve(attendees.size());
+            for (const KCalendarCore::Attendee &attendee : attendees) {
+                entry.attendees.append(attendee.fullName());
+            }
+        }
+        state->entries.append(entry);
+    }
+    mState = state;
+
+    if (state->entries.isEmpty()) {
+        state->pendingChunks = 1;
+        QMetaObject::invokeMethod(
+            this,
+            [this, state]() {
+                chunkFinished(state, {});
+            },
+            Qt::QueuedConnection);
+        return;
+    }
+
+    for (qsizetype begin = 0; begin < state->entries.size(); begin += chunkSize) {
+        const qsizetype end = std::min(begin + chunkSize, state->entries.size());
+        ++state->pendingChunks;
+        mThreadPool.start([this, state, begin, end]() {
+            const SearchState &snapshot = *state;
+            QList<qsizetype> matches;
+            for (qsizetype i = begin; i < end; ++i) {
+                if (snapshot.cancelled) {
+                    return;
+                }
+                if (entryMatches(snapshot.entries.at(i), snapshot.regularExpression, snapshot.fields)) {
+                    matches.append(i);
+                }
+            }
+            QMetaObject::invokeMethod(
+                this,
+                [this, state, matches]() {
+                    chunkFinished(state, matches);
+                },
+                Qt::QueuedConnection);
+        });
+    }
+}
+
+void SearchEngine::cancel()
+{
+    if (mState) {
+        mState->cancelled = true;
+        mState.reset();
+    }
+}
+
+bool SearchEngine::isRunning() const
+{
+    return mState != nullptr;
+}
+
+void SearchEngine::chunkFinished(const std::shared_ptr<SearchState> &state, const QList<qsizetype> &matches)
+{
+    if (state != mState) {
+        // Results of a cancelled search
+        return;
+    }
+
+    if (!matches.isEmpty()) {
+        KCalendarCore::Incidence::List incidences;
+        incidences.reserve(matches.size());
+        for (const qsizetype index : matches) {
+            incidences.append(state->incidences.at(index));
+        }
+        Q_EMIT matchesFound(incidences);
+        if (state != mState) {
+            // A receiver started a new search
+            return;
+        }
+    }
+
+    if (--state->pendingChunks == 0) {
+        mState.reset();
+        Q_EMIT finished();
+    }
+}
+
+#include "moc_searchengine.cpp"
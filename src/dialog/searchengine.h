@@ -0,0 +1,76 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include <KCalendarCore/Incidence>
+
+#include <QObject>
+#include <QRegularExpression>
+#include <QThreadPool>
+
+#include <memory>
+
+/**
+  Matches incidences against a regular expression on a thread pool.
+
+  The searched texts are copied into an immutable snapshot when the search
+  starts, so the workers never touch the incidences themselves. Matches are
+  delivered in batches on the thread the engine lives in.
+
+  @short Background search used by the SearchDialog
+*/
+class SearchEngine : public QObject
+{
+    Q_OBJECT
+public:
+    enum SearchField {
+        Summary = 0x01,
+        Description = 0x02,
+        Categories = 0x04,
+        Location = 0x08,
+        Attendees = 0x10,
+    };
+    Q_DECLARE_FLAGS(SearchFields, SearchField)
+
+    explicit SearchEngine(QObject *parent = nullptr);
+    ~SearchEngine() override;
+
+    /**
+      Starts matching @p incidences against @p regularExpression in the given
+      @p fields. A search that is still running is cancelled first.
+    */
+    void start(const KCalendarCore::Incidence::List &incidences, const QRegularExpression &regularExpression, SearchFields fields);
+
+    /**
+      Cancels the running search. Batches that were not delivered yet are dropped.
+    */
+    void cancel();
+
+    [[nodiscard]] bool isRunning() const;
+
+Q_SIGNALS:
+    /**
+      Emitted for each batch of incidences matching the running search.
+    */
+    void matchesFound(const KCalendarCore::Incidence::List &incidences);
+
+    /**
+      Emitted once all batches of the running search have been delivered.
+    */
+    void finished();
+
+private:
+    struct SearchState;
+    void chunkFinished(const std::shared_ptr<SearchState> &state, const QList<qsizetype> &matches);
+
+    QThreadPool mThreadPool;
+    std::shared_ptr<SearchState> mState;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(SearchEngine::SearchFields)
@@ -0,0 +1,434 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "searchindex.h"
+#include "korganizer_debug.h"
+
+#include <Akonadi/CalendarUtils>
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+constexpr quint32 indexMagic = 0x4B4F5349; // "KOSI"
+constexpr quint32 indexVersion = 2;
+
+// Delay before modifications are written to disk
+constexpr int saveDelay = 10 * 1000;
+
+// Indexed words are looked up by the trigrams of the query words
+constexpr qsizetype trigramLength = 3;
+
+constexpr SearchEngine::SearchField indexedFields[] = {
+    SearchEngine::Summary,
+    SearchEngine::Description,
+    SearchEngine::Categories,
+    SearchEngine::Location,
+    SearchEngine::Attendees,
+};
+
+int fieldIndex(SearchEngine::SearchField field)
+{
+    return std::distance(std::begin(indexedFields), std::ranges::find(indexedFields, field));
+}
+
+quint64 postingKey(quint32 tokenId, int field)
+{
+    return (quint64(tokenId) << 3) | quint64(field);
+}
+
+// Splits @p text into its case folded words
+void appendWords(const QString &text, QSet<QString> &words)
+{
+    const QString folded = text.toCaseFolded();
+    qsizetype start = -1;
+    for (qsizetype i = 0; i <= folded.size(); ++i) {
+        const bool isWordChar = i < folded.size() && folded.at(i).isLetterOrNumber();
+        if (isWordChar && start < 0) {
+            start = i;
+        } else if (!isWordChar && start >= 0) {
+            words.insert(folded.mid(start, i - start));
+            start = -1;
+        }
+    }
+}
+
+QSet<QString> fieldWords(const KCalendarCore::Incidence::Ptr &incidence, SearchEngine::SearchField field)
+{
+    QSet<QString> words;
+    switch (field) {
+    case SearchEngine::Summary:
+        appendWords(incidence->summary(), words);
+        break;
+    case SearchEngine::Description:
+        appendWords(incidence->description(), words);
+        break;
+    case SearchEngine::Categories:
+        appendWords(incidence->categoriesStr(), words);
+        break;
+    case SearchEngine::Location:
+        appendWords(incidence->location(), words);
+        break;
+    case SearchEngine::Attendees: {
+        const KCalendarCore::Attendee::List attendees = incidence->attendees();
+        for (const KCalendarCore::Attendee &attendee : attendees) {
+            appendWords(attendee.fullName(), words);
+        }
+        break;
+    }
+    }
+    return words;
+}
+
+QSet<Akonadi::Item::Id> toSet(const QList<Akonadi::Item::Id> &ids)
+{
+    return {ids.cbegin(), ids.cend()};
+}
+}
+
+SearchIndex::SearchIndex(const QString &fileName, QObject *parent)
+    : QObject(parent)
+    , mFileName(fileName)
+{
+    mSaveTimer.setSingleShot(true);
+    mSaveTimer.setInterval(saveDelay);
+    connect(&mSaveTimer, &QTimer::timeout, this, &SearchIndex::save);
+}
+
+SearchIndex::~SearchIndex()
+{
+    if (mDirty) {
+        save();
+    }
+}
+
+QString SearchIndex::defaultFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QLatin1StringView("/korganizer/searchindex");
+}
+
+void SearchIndex::updateItem(const Akonadi::Item &item)
+{
+    const KCalendarCore::Incidence::Ptr incidence = Akonadi::CalendarUtils::incidence(item);
+    if (incidence) {
+        updateItem(item.id(), item.revision(), incidence, item.parentCollection().id());
+    }
+}
+
+void SearchIndex::updateItem(Akonadi::Item::Id id, int revision, const KCalendarCore::Incidence::Ptr &incidence, Akonadi::Collection::Id collectionId)
+{
+    Q_ASSERT(incidence);
+    if (isCurrent(id, revision)) {
+        return;
+    }
+
+    removeItem(id);
+
+    IndexedItem entry;
+    entry.revision = revision;
+    entry.collectionId = collectionId;
+    for (const SearchEngine::SearchField field : indexedFields) {
+        const QSet<QString> words = fieldWords(incidence, field);
+        for (const QString &word : words) {
+            entry.postingKeys.append(postingKey(tokenId(word), fieldIndex(field)));
+        }
+    }
+    addItem(id, entry);
+    scheduleSave();
+}
+
+void SearchIndex::removeItem(Akonadi::Item::Id id)
+{
+    ensureLoaded();
+    const auto it = mItems.constFind(id);
+    if (it == mItems.cend()) {
+        return;
+    }
+
+    for (const quint64 key : it->postingKeys) {
+        removePosting(key, id);
+    }
+    mItems.erase(it);
+    scheduleSave();
+}
+
+void SearchIndex::removeMissingItems(Akonadi::Collection::Id collectionId, const QSet<Akonadi::Item::Id> &presentIds)
+{
+    ensureLoaded();
+    QList<Akonadi::Item::Id> missingIds;
+    for (auto it = mItems.cbegin(), end = mItems.cend(); it != end; ++it) {
+        if (it->collectionId == collectionId && !presentIds.contains(it.key())) {
+            missingIds.append(it.key());
+        }
+    }
+    for (const Akonadi::Item::Id id : std::as_const(missingIds)) {
+        removeItem(id);
+    }
+}
+
+bool SearchIndex::isCurrent(Akonadi::Item::Id id, int revision) const
+{
+    ensureLoaded();
+    const auto it = mItems.constFind(id);
+    return it != mItems.cend() && it->revision == revision;
+}
+
+Akonadi::Collection::Id SearchIndex::collectionId(Akonadi::Item::Id id) const
+{
+    ensureLoaded();
+    return mItems.value(id).collectionId;
+}
+
+std::optional<QSet<Akonadi::Item::Id>> SearchIndex::candidates(const QString &wildcardPattern, SearchEngine::SearchFields fields) const
+{
+    ensureLoaded();
+
+    // Character classes and escapes would have to be expanded to find their words
+    if (wildcardPattern.contains(u'[') || wildcardPattern.contains(u']') || wildcardPattern.contains(u'\\')) {
+        return std::nullopt;
+    }
+
+    // Every word of the literal parts of the pattern is contained in a word of a matching field
+    QSet<QString> queryWords;
+    const QStringList literals = wildcardPattern.split(QRegularExpression(QStringLiteral("[*?]")), Qt::SkipEmptyParts);
+    for (const QString &literal : literals) {
+        appendWords(literal, queryWords);
+    }
+    queryWords.removeIf([](const QString &word) {
+        return word.size() < trigramLength;
+    });
+    if (queryWords.isEmpty()) {
+        return std::nullopt;
+    }
+
+    // Indexed words containing each query word
+    QList<QList<quint32>> matchingTokens;
+    matchingTokens.reserve(queryWords.size());
+    for (const QString &queryWord : std::as_const(queryWords)) {
+        const QList<quint32> tokens = tokensContaining(queryWord);
+        if (tokens.isEmpty()) {
+            // No indexed item contains this word
+            return QSet<Akonadi::Item::Id>();
+        }
+        matchingTokens.append(tokens);
+    }
+
+    QSet<Akonadi::Item::Id> result;
+    for (const SearchEngine::SearchField field : indexedFields) {
+        if (!(fields & field)) {
+            continue;
+        }
+        std::optional<QSet<Akonadi::Item::Id>> fieldResult;
+        for (const QList<quint32> &tokens : std::as_const(matchingTokens)) {
+            QSet<Akonadi::Item::Id> ids;
+            for (const quint32 token : tokens) {
+                const auto posting = mPostings.constFind(postingKey(token, fieldIndex(field)));
+                if (posting != mPostings.cend()) {
+                    ids.unite(toSet(*posting));
+                }
+            }
+            if (fieldResult) {
+                fieldResult->intersect(ids);
+            } else {
+                fieldResult = ids;
+            }
+            if (fieldResult->isEmpty()) {
+                break;
+            }
+        }
+        result.unite(*fieldResult);
+    }
+    return result;
+}
+
+bool SearchIndex::save()
+{
+    mSaveTimer.stop();
+    if (!mLoaded) {
+        return true;
+    }
+
+    QDir().mkpath(QFileInfo(mFileName).absolutePath());
+    QSaveFile file(mFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KORGANIZER_LOG) << "Unable to write search index" << mFileName << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << indexMagic << indexVersion << mTokens << qint64(mItems.size());
+    for (auto it = mItems.cbegin(), end = mItems.cend(); it != end; ++it) {
+        stream << qint64(it.key()) << qint32(it->revision) << qint64(it->collectionId) << it->postingKeys;
+    }
+
+    if (!file.commit()) {
+        qCWarning(KORGANIZER_LOG) << "Unable to write search index" << mFileName << file.errorString();
+        return false;
+    }
+    mDirty = false;
+    return true;
+}
+
+void SearchIndex::ensureLoaded() const
+{
+    if (!mLoaded) {
+        const_cast<SearchIndex *>(this)->load();
+    }
+}
+
+void SearchIndex::load()
+{
+    mLoaded = true;
+
+    QFile file(mFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != indexMagic || version != indexVersion) {
+        qCDebug(KORGANIZER_LOG) << "Ignoring search index with unknown format" << mFileName;
+        return;
+    }
+
+    // Tokens which are no longer used by any item are dropped while loading
+    QStringList tokens;
+    qint64 itemCount = 0;
+    stream >> tokens >> itemCount;
+    for (qint64 i = 0; i < itemCount && stream.status() == QDataStream::Ok; ++i) {
+        qint64 id = 0;
+        qint32 revision = 0;
+        qint64 collectionId = -1;
+        QList<quint64> keys;
+        stream >> id >> revision >> collectionId >> keys;
+
+        IndexedItem entry;
+        entry.revision = revision;
+        entry.collectionId = collectionId;
+        entry.postingKeys.reserve(keys.size());
+        for (const quint64 key : std::as_const(keys)) {
+            const quint64 oldTokenId = key >> 3;
+            if (oldTokenId < quint64(tokens.size())) {
+                entry.postingKeys.append(postingKey(tokenId(tokens.at(oldTokenId)), key & 0x7));
+            }
+        }
+        addItem(id, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(KORGANIZER_LOG) << "Search index is corrupted, rebuilding it" << mFileName;
+        mItems.clear();
+        mPostings.clear();
+        mTokenIds.clear();
+        mTokens.clear();
+        mTrigramTokens.clear();
+    }
+}
+
+void SearchIndex::scheduleSave()
+{
+    mDirty = true;
+    if (!mSaveTimer.isActive()) {
+        mSaveTimer.start();
+    }
+}
+
+quint32 SearchIndex::tokenId(const QString &token)
+{
+    const auto it = mTokenIds.constFind(token);
+    if (it != mTokenIds.cend()) {
+        return *it;
+    }
+    const quint32 id = mTokens.size();
+    mTokens.append(token);
+    mTokenIds.insert(token, id);
+    for (qsizetype i = 0; i + trigramLength <= token.size(); ++i) {
+        // Ids are handed out in ascending order, so appending keeps the lists sorted
+        QList<quint32> &tokens = mTrigramTokens[token.mid(i, trigramLength)];
+        if (tokens.isEmpty() || tokens.constLast() != id) {
+            tokens.append(id);
+        }
+    }
+    return id;
+}
+
+QList<quint32> SearchIndex::tokensContaining(const QString &word) const
+{
+    Q_ASSERT(word.size() >= trigramLength);
+
+    // Intersect the tokens of all trigrams of the word, smallest list first
+    QList<const QList<quint32> *> trigramTokens;
+    for (qsizetype i = 0; i + trigramLength <= word.size(); ++i) {
+        const auto it = mTrigramTokens.constFind(word.mid(i, trigramLength));
+        if (it == mTrigramTokens.cend()) {
+            return {};
+        }
+        trigramTokens.append(&*it);
+    }
+    std::ranges::sort(trigramTokens, {}, &QList<quint32>::size);
+
+    QList<quint32> tokens = *trigramTokens.constFirst();
+    for (qsizetype i = 1; i < trigramTokens.size() && !tokens.isEmpty(); ++i) {
+        QList<quint32> intersection;
+        std::ranges::set_intersection(tokens, *trigramTokens.at(i), std::back_inserter(intersection));
+        tokens = std::move(intersection);
+    }
+
+    // Having all trigrams doesn't mean having them in the right order
+    tokens.removeIf([this, &word](quint32 token) {
+        return !mTokens.at(token).contains(word);
+    });
+    return tokens;
+}
+
+void SearchIndex::addPosting(quint64 key, Akonadi::Item::Id id)
+{
+    QList<Akonadi::Item::Id> &ids = mPostings[key];
+    const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        ids.insert(it, id);
+    }
+}
+
+void SearchIndex::removePosting(quint64 key, Akonadi::Item::Id id)
+{
+    const auto posting = mPostings.find(key);
+    if (posting == mPostings.end()) {
+        return;
+    }
+    const auto it = std::lower_bound(posting->begin(), posting->end(), id);
+    if (it != posting->end() && *it == id) {
+        posting->erase(it);
+    }
+    if (posting->isEmpty()) {
+        mPostings.erase(posting);
+    }
+}
+
+void SearchIndex::addItem(Akonadi::Item::Id id, IndexedItem entry)
+{
+    for (const quint64 key : std::as_const(entry.postingKeys)) {
+        addPosting(key, id);
+    }
+    mItems.insert(id, std::move(entry));
+}
+
+#include "moc_searchindex.cpp"
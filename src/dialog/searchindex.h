@@ -0,0 +1,115 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "korganizerprivate_export.h"
+#include "searchengine.h"
+
+#include <Akonadi/Collection>
+#include <Akonadi/Item>
+
+#include <KCalendarCore/Incidence>
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+
+#include <optional>
+
+/**
+  Inverted index of the words found in the searchable fields of incidences.
+
+  Items are keyed by their Akonadi id and revision, so outdated entries can
+  be detected and refreshed. The index is stored on disk and loaded on first
+  use. It only narrows down the candidates of a search; the matches still
+  have to be verified with the regular expression.
+
+  @short Persistent word index used by the SearchDialog
+*/
+class KORGANIZERPRIVATE_EXPORT SearchIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SearchIndex(const QString &fileName, QObject *parent = nullptr);
+    ~SearchIndex() override;
+
+    /**
+      Returns the location of the index of the current user.
+    */
+    [[nodiscard]] static QString defaultFileName();
+
+    /**
+      Indexes the incidence of @p item, unless this revision is indexed already.
+    */
+    void updateItem(const Akonadi::Item &item);
+    void updateItem(Akonadi::Item::Id id, int revision, const KCalendarCore::Incidence::Ptr &incidence, Akonadi::Collection::Id collectionId = -1);
+
+    void removeItem(Akonadi::Item::Id id);
+
+    /**
+      Removes the items of collection @p collectionId which are not in
+      @p presentIds, e.g. because they were deleted while KOrganizer was not
+      running.
+    */
+    void removeMissingItems(Akonadi::Collection::Id collectionId, const QSet<Akonadi::Item::Id> &presentIds);
+
+    /**
+      Returns true if revision @p revision of item @p id is indexed.
+    */
+    [[nodiscard]] bool isCurrent(Akonadi::Item::Id id, int revision) const;
+
+    /**
+      Returns the collection item @p id was indexed in, or -1 if it is not
+      indexed.
+    */
+    [[nodiscard]] Akonadi::Collection::Id collectionId(Akonadi::Item::Id id) const;
+
+    /**
+      Returns the ids of the indexed items which may match @p wildcardPattern
+      in one of @p fields, or std::nullopt if the pattern contains no words
+      the index can use. Items which are not indexed are never returned, so
+      the caller has to search those itself.
+    */
+    [[nodiscard]] std::optional<QSet<Akonadi::Item::Id>> candidates(const QString &wildcardPattern, SearchEngine::SearchFields fields) const;
+
+    /**
+      Writes the index to disk. Returns true on success.
+    */
+    bool save();
+
+private:
+    struct IndexedItem {
+        int revision = -1;
+        Akonadi::Collection::Id collectionId = -1;
+        QList<quint64> postingKeys;
+    };
+
+    void ensureLoaded() const;
+    void load();
+    void scheduleSave();
+    quint32 tokenId(const QString &token);
+    [[nodiscard]] QList<quint32> tokensContaining(const QString &word) const;
+    void addPosting(quint64 key, Akonadi::Item::Id id);
+    void removePosting(quint64 key, Akonadi::Item::Id id);
+    void addItem(Akonadi::Item::Id id, IndexedItem entry);
+
+    const QString mFileName;
+    bool mLoaded = false;
+    bool mDirty = false;
+    QTimer mSaveTimer;
+
+    QHash<Akonadi::Item::Id, IndexedItem> mItems;
+    // Sorted lists of item ids, keyed by (token id << 3 | field)
+    QHash<quint64, QList<Akonadi::Item::Id>> mPostings;
+    QHash<QString, quint32> mTokenIds;
+    QStringList mTokens;
+    // Sorted lists of token ids, keyed by the trigrams the tokens contain
+    QHash<QString, QList<quint32>> mTrigramTokens;
+};
@@ -0,0 +1,95 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "searchindexer.h"
+#include "searchindex.h"
+
+#include <Akonadi/CalendarUtils>
+#include <Akonadi/EntityTreeModel>
+
+SearchIndexer::SearchIndexer(SearchIndex *index, const Akonadi::ETMCalendar::Ptr &calendar, QObject *parent)
+    : QObject(parent)
+    , mIndex(index)
+    , mCalendar(calendar)
+{
+    Q_ASSERT(mIndex);
+    mCalendar->registerObserver(this);
+    connect(mCalendar->entityTreeModel(), &Akonadi::EntityTreeModel::collectionPopulated, this, &SearchIndexer::indexCollection);
+}
+
+SearchIndexer::~SearchIndexer()
+{
+    mCalendar->unregisterObserver(this);
+}
+
+SearchIndex *SearchIndexer::index() const
+{
+    return mIndex;
+}
+
+bool SearchIndexer::isIndexed(Akonadi::Collection::Id collectionId)
+{
+    if (mIndexedCollections.contains(collectionId)) {
+        return true;
+    }
+    // The model is shared, so the collection may have been loaded before we were created
+    if (mCalendar->entityTreeModel()->isCollectionPopulated(collectionId)) {
+        indexCollection(collectionId);
+        return true;
+    }
+    return false;
+}
+
+void SearchIndexer::indexCollection(Akonadi::Collection::Id collectionId)
+{
+    // Most items are current already, they were indexed in an earlier session
+    // or while the collection was loading
+    QSet<Akonadi::Item::Id> presentIds;
+    const Akonadi::Item::List items = mCalendar->items(collectionId);
+    for (const Akonadi::Item &item : items) {
+        const KCalendarCore::Incidence::Ptr incidence = Akonadi::CalendarUtils::incidence(item);
+        if (incidence) {
+            mIndex->updateItem(item.id(), item.revision(), incidence, collectionId);
+            mItemIds.insert(incidence.data(), item.id());
+            presentIds.insert(item.id());
+        }
+    }
+    mIndex->removeMissingItems(collectionId, presentIds);
+    mIndexedCollections.insert(collectionId);
+}
+
+void SearchIndexer::updateIncidence(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    const Akonadi::Item item = mCalendar->item(incidence);
+    if (item.isValid()) {
+        mIndex->updateItem(item.id(), item.revision(), incidence, item.parentCollection().id());
+        mItemIds.insert(incidence.data(), item.id());
+    }
+}
+
+void SearchIndexer::calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    updateIncidence(incidence);
+}
+
+void SearchIndexer::calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    updateIncidence(incidence);
+}
+
+void SearchIndexer::calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar)
+{
+    Q_UNUSED(calendar)
+    const auto it = mItemIds.constFind(incidence.data());
+    if (it != mItemIds.cend()) {
+        mIndex->removeItem(*it);
+        mItemIds.erase(it);
+    }
+}
+
+#include "moc_searchindexer.cpp"
@@ -0,0 +1,66 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "korganizerprivate_export.h"
+
+#include <Akonadi/ETMCalendar>
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+class SearchIndex;
+
+/**
+  Keeps a SearchIndex in sync with a calendar.
+
+  Incidences added, changed or removed in the calendar, which includes the
+  changes made by other applications and reported by the Akonadi monitor,
+  are indexed as they arrive. Once a collection is fully loaded, the index
+  entries of its items which no longer exist are purged.
+
+  @short Feeds the SearchIndex from the calendar
+*/
+class KORGANIZERPRIVATE_EXPORT SearchIndexer : public QObject, public KCalendarCore::Calendar::CalendarObserver
+{
+    Q_OBJECT
+public:
+    SearchIndexer(SearchIndex *index, const Akonadi::ETMCalendar::Ptr &calendar, QObject *parent = nullptr);
+    ~SearchIndexer() override;
+
+    [[nodiscard]] SearchIndex *index() const;
+
+    /**
+      Returns true if every item of collection @p collectionId is indexed.
+      Collections which are not loaded yet are not indexed.
+    */
+    [[nodiscard]] bool isIndexed(Akonadi::Collection::Id collectionId);
+
+protected:
+    /**
+     *  Reimplemented from KCalendarCore::Calendar::CalendarObserver
+     */
+    void calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar) override;
+
+private:
+    void indexCollection(Akonadi::Collection::Id collectionId);
+    void updateIncidence(const KCalendarCore::Incidence::Ptr &incidence);
+
+    SearchIndex *const mIndex;
+    const Akonadi::ETMCalendar::Ptr mCalendar;
+
+    /** the collections whose items have all been indexed */
+    QSet<Akonadi::Collection::Id> mIndexedCollections;
+
+    /** the item ids of the indexed incidences, their items are gone when they are deleted */
+    QHash<const KCalendarCore::Incidence *, Akonadi::Item::Id> mItemIds;
+};
@@ -0,0 +1,282 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "icalexporter.h"
+#include "korganizer_debug.h"
+
+#include <KCalendarCore/ICalFormat>
+#include <KCalendarCore/MemoryCalendar>
+
+#include <Libkdepim/ProgressManager>
+
+#include <KLocalizedString>
+
+#include <QFutureWatcher>
+#include <QSaveFile>
+#include <QThread>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+
+namespace
+{
+constexpr QByteArrayView timeZoneBegin = "BEGIN:VTIMEZONE\r\n";
+constexpr QByteArrayView timeZoneEnd = "END:VTIMEZONE\r\n";
+constexpr QByteArrayView timeZoneId = "\r\nTZID:";
+
+QByteArray serializeChunk(const KCalendarCore::Incidence::List &incidences)
+{
+    KCalendarCore::ICalFormat format;
+    QByteArray data;
+    for (const KCalendarCore::Incidence::Ptr &incidence : incidences) {
+        // toRawString() appends the zones the incidence uses, they are
+        // written once at the end of the file instead
+        const QByteArray text = format.toRawString(incidence);
+        qsizetype from = 0;
+        for (qsizetype zone = text.indexOf(timeZoneBegin); zone >= 0; zone = text.indexOf(timeZoneBegin, from)) {
+            data += QByteArrayView(text).sliced(from, zone - from);
+            const qsizetype zoneEnd = text.indexOf(timeZoneEnd, zone);
+            if (zoneEnd < 0) {
+                from = text.size();
+                break;
+            }
+            from = zoneEnd + timeZoneEnd.size();
+        }
+        data += QByteArrayView(text).sliced(from);
+    }
+    return data;
+}
+
+QByteArray serializeCalendar(const KCalendarCore::Calendar::Ptr &calendar)
+{
+    KCalendarCore::ICalFormat format;
+    return format.toString(calendar).toUtf8();
+}
+
+constexpr QByteArrayView calendarEnd = "END:VCALENDAR\r\n";
+}
+
+ICalExporter::ICalExporter(const KCalendarCore::Calendar::Ptr &calendar, const QString &fileName, QObject *parent)
+    : QObject(parent)
+    , mCalendar(calendar)
+    , mFileName(fileName)
+{
+}
+
+ICalExporter::~ICalExporter()
+{
+    // Tasks still running only hold their own copies of the incidences
+    qDeleteAll(mPending);
+}
+
+void ICalExporter::start()
+{
+    mFile = std::make_unique<QSaveFile>(mFileName);
+    if (!mFile->open(QIODevice::WriteOnly)) {
+        fail(mFile->errorString());
+        return;
+    }
+
+    // The order of ICalFormat::toString()
+    mIncidences.append(mCalendar->rawTodos());
+    mIncidences.append(mCalendar->rawEvents());
+    mIncidences.append(mCalendar->rawJournals());
+
+    mProgressItem = KPIM::ProgressManager::createProgressItem(KPIM::ProgressManager::getUniqueID(), i18nc("@info:progress", "Exporting calendar"));
+    connect(mProgressItem, &KPIM::ProgressItem::progressItemCanceled, this, &ICalExporter::cancel);
+
+    if (mFile->write(header()) < 0) {
+        fail(mFile->errorString());
+        return;
+    }
+    dispatchChunks();
+    writeFinishedChunks();
+}
+
+void ICalExporter::cancel()
+{
+    if (mFinished || mCanceled) {
+        return;
+    }
+    mCanceled = true;
+    if (mFile) {
+        mFile->cancelWriting();
+    }
+    if (mPending.isEmpty()) {
+        finish(false);
+    }
+}
+
+QString ICalExporter::errorString() const
+{
+    return mErrorString;
+}
+
+void ICalExporter::dispatchChunks()
+{
+    // Enough chunks to keep all cores busy while the oldest one is written
+    const int maximumPending = 2 * std::max(1, QThread::idealThreadCount());
+    while (!mCanceled && mPending.size() < maximumPending && mDispatched < mIncidences.size()) {
+        const int end = std::min<int>(mDispatched + chunkSize, mIncidences.size());
+        KCalendarCore::Incidence::List chunk;
+        chunk.reserve(end - mDispatched);
+        for (; mDispatched < end; ++mDispatched) {
+            const KCalendarCore::Incidence::Ptr &incidence = mIncidences.at(mDispatched);
+            noteTimeZones(incidence);
+            // The tasks work on copies, the calendar may change meanwhile
+            chunk.append(KCalendarCore::Incidence::Ptr(incidence->clone()));
+            mIncidences[mDispatched].clear();
+        }
+
+        auto watcher = new QFutureWatcher<QByteArray>(this);
+        connect(watcher, &QFutureWatcher<QByteArray>::finished, this, &ICalExporter::writeFinishedChunks);
+        mPending.append(watcher);
+        watcher->setFuture(QtConcurrent::run(serializeChunk, std::move(chunk)));
+    }
+}
+
+void ICalExporter::writeFinishedChunks()
+{
+    while (!mPending.isEmpty() && mPending.constFirst()->isFinished()) {
+        QFutureWatcher<QByteArray> *watcher = mPending.takeFirst();
+        const QByteArray data = watcher->result();
+        const int size = std::min<int>(chunkSize, mIncidences.size() - mWritten);
+        delete watcher;
+        if (mCanceled || mFinished) {
+            continue;
+        }
+        if (mFile->write(data) < 0) {
+            fail(mFile->errorString());
+            continue;
+        }
+        mWritten += size;
+        if (mProgressItem) {
+            mProgressItem->setProgress(100 * mWritten / mIncidences.size());
+        }
+    }
+
+    if (mCanceled || mFinished) {
+        if (mPending.isEmpty() && !mFinished) {
+            finish(false);
+        }
+        return;
+    }
+
+    dispatchChunks();
+    if (!mPending.isEmpty()) {
+        return;
+    }
+
+    mIncidences.clear();
+    if (mFile->write(timeZones()) < 0 || mFile->write(calendarEnd.data(), calendarEnd.size()) < 0) {
+        fail(mFile->errorString());
+        return;
+    }
+    if (!mFile->commit()) {
+        fail(mFile->errorString());
+        return;
+    }
+    finish(true);
+}
+
+void ICalExporter::noteTimeZones(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    const std::array<QDateTime, 2> times{incidence->dtStart(), incidence->dateTime(KCalendarCore::IncidenceBase::RoleEndTimeZone)};
+    for (int zoneRole = 0; zoneRole < 2; ++zoneRole) {
+        if (!times[zoneRole].isValid()) {
+            continue;
+        }
+        const QByteArray zoneId = times[zoneRole].timeZone().id();
+        auto zone = mTimeZoneUsers.find(zoneId);
+        if (zone == mTimeZoneUsers.end()) {
+            zone = mTimeZoneUsers.insert(zoneId, {});
+            mTimeZoneOrder.append(zoneId);
+        }
+        TimeZoneUsers &users = *zone;
+        for (int timeRole = 0; timeRole < 2; ++timeRole) {
+            const QDateTime &time = times[timeRole];
+            auto &user = users[zoneRole * 2 + timeRole];
+            if (time.isValid() && (!user.second || time < user.first)) {
+                user = {time, incidence};
+            }
+        }
+    }
+}
+
+QByteArray ICalExporter::header() const
+{
+    // The calendar properties, as written for an empty calendar
+    KCalendarCore::MemoryCalendar::Ptr empty(new KCalendarCore::MemoryCalendar(mCalendar->timeZone()));
+    empty->setId(mCalendar->id());
+    empty->setName(mCalendar->name());
+    empty->setCustomProperties(mCalendar->customProperties());
+    const QByteArray text = serializeCalendar(empty);
+    return text.left(text.lastIndexOf(calendarEnd));
+}
+
+QByteArray ICalExporter::timeZones() const
+{
+    // Let ICalFormat describe the zones from the incidences using them
+    // earliest and keep only the descriptions
+    KCalendarCore::MemoryCalendar::Ptr users(new KCalendarCore::MemoryCalendar(mCalendar->timeZone()));
+    for (const QByteArray &zoneId : mTimeZoneOrder) {
+        for (const auto &user : mTimeZoneUsers.value(zoneId)) {
+            if (user.second && !users->incidence(user.second->uid(), user.second->recurrenceId())) {
+                users->addIncidence(KCalendarCore::Incidence::Ptr(user.second->clone()));
+            }
+        }
+    }
+    const QByteArray text = serializeCalendar(users);
+
+    QHash<QByteArray, QByteArrayView> descriptions;
+    for (qsizetype from = text.indexOf(timeZoneBegin); from >= 0; from = text.indexOf(timeZoneBegin, from)) {
+        const qsizetype to = text.indexOf(timeZoneEnd, from);
+        if (to < 0) {
+            break;
+        }
+        const QByteArrayView description = QByteArrayView(text).sliced(from, to + timeZoneEnd.size() - from);
+        const qsizetype idStart = description.indexOf(timeZoneId);
+        if (idStart >= 0) {
+            const qsizetype idFrom = idStart + timeZoneId.size();
+            descriptions.insert(description.sliced(idFrom, description.indexOf("\r\n", idFrom) - idFrom).toByteArray(), description);
+        }
+        from = to;
+    }
+
+    // In the order of their first use, which is how ICalFormat writes them
+    QByteArray result;
+    for (const QByteArray &zoneId : mTimeZoneOrder) {
+        result += descriptions.value(zoneId);
+    }
+    return result;
+}
+
+void ICalExporter::fail(const QString &errorString)
+{
+    qCWarning(KORGANIZER_LOG) << "Exporting to" << mFileName << "failed:" << errorString;
+    mErrorString = errorString;
+    if (mFile) {
+        mFile->cancelWriting();
+    }
+    mCanceled = true;
+    if (mPending.isEmpty()) {
+        finish(false);
+    }
+}
+
+void ICalExporter::finish(bool success)
+{
+    mFinished = true;
+    mFile.reset();
+    if (mProgressItem) {
+        mProgressItem->setComplete();
+    }
+    Q_EMIT finished(success);
+}
+
+#include "moc_icalexporter.cpp"
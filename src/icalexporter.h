@@ -0,0 +1,112 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "korganizerprivate_export.h"
+
+#include <KCalendarCore/Calendar>
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+
+#include <array>
+#include <memory>
+
+class QSaveFile;
+template<typename T>
+class QFutureWatcher;
+
+namespace KPIM
+{
+class ProgressItem;
+}
+
+/**
+  Writes a calendar to an iCalendar file.
+
+  The result has the same content as saving the calendar with
+  KCalendarCore::FileStorage and ICalFormat, but the calendar is never
+  serialized into a single string. Incidences are serialized in chunks on
+  worker threads and written to the file in order as the chunks complete,
+  with a bounded number of chunks in flight. Only the time zones and the
+  calendar properties are serialized by ICalFormat itself.
+
+  The progress is shown in the status bar, where the export can be
+  canceled. The file is only replaced once the export succeeded.
+
+  @short Streaming iCalendar export
+*/
+class KORGANIZERPRIVATE_EXPORT ICalExporter : public QObject
+{
+    Q_OBJECT
+public:
+    /** the number of incidences serialized by one task */
+    static constexpr int chunkSize = 500;
+
+    ICalExporter(const KCalendarCore::Calendar::Ptr &calendar, const QString &fileName, QObject *parent = nullptr);
+    ~ICalExporter() override;
+
+    /**
+      Starts the export. finished() is emitted when it is done.
+    */
+    void start();
+
+    /**
+      Stops the export. The file is left untouched.
+    */
+    void cancel();
+
+    /** the reason the export failed, empty if it succeeded or was canceled */
+    [[nodiscard]] QString errorString() const;
+
+Q_SIGNALS:
+    /**
+      Emitted when the export stopped. @p success tells whether the file
+      was written.
+    */
+    void finished(bool success);
+
+private:
+    void dispatchChunks();
+    void writeFinishedChunks();
+    void noteTimeZones(const KCalendarCore::Incidence::Ptr &incidence);
+    [[nodiscard]] QByteArray header() const;
+    [[nodiscard]] QByteArray timeZones() const;
+    void fail(const QString &errorString);
+    void finish(bool success);
+
+    const KCalendarCore::Calendar::Ptr mCalendar;
+    const QString mFileName;
+    std::unique_ptr<QSaveFile> mFile;
+    QPointer<KPIM::ProgressItem> mProgressItem;
+
+    /** the incidences in the order ICalFormat writes them */
+    KCalendarCore::Incidence::List mIncidences;
+    int mDispatched = 0;
+    int mWritten = 0;
+    /** the chunks being serialized, oldest first */
+    QList<QFutureWatcher<QByteArray> *> mPending;
+
+    /**
+      For each time zone the incidences with the earliest start and end
+      times, once for the zone used by the start and once for the end.
+      ICalFormat describes each zone from its earliest use, so these are
+      enough to let it write the same time zones.
+    */
+    using TimeZoneUsers = std::array<std::pair<QDateTime, KCalendarCore::Incidence::Ptr>, 4>;
+    QHash<QByteArray, TimeZoneUsers> mTimeZoneUsers;
+    /** the ids of the time zones in the order of their first use, as ICalFormat writes them */
+    QList<QByteArray> mTimeZoneOrder;
+
+    QString mErrorString;
+    bool mCanceled = false;
+    bool mFinished = false;
+};
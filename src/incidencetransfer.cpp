@@ -0,0 +1,177 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "incidencetransfer.h"
+#include "korganizer_debug.h"
+
+#include <Akonadi/CalendarUtils>
+#include <Akonadi/History>
+#include <Akonadi/ItemCreateJob>
+#include <Akonadi/ItemMoveJob>
+#include <Akonadi/TransactionSequence>
+
+#include <KCalendarCore/CalFormat>
+
+#include <Libkdepim/ProgressManager>
+
+#include <KLocalizedString>
+
+#include <algorithm>
+
+IncidenceTransfer::IncidenceTransfer(Mode mode,
+                                     const Akonadi::Item::List &items,
+                                     const Akonadi::Collection &destination,
+                                     Akonadi::History *history,
+                                     QObject *parent)
+    : QObject(parent)
+    , mMode(mode)
+    , mItems(items)
+    , mDestination(destination)
+    , mHistory(history)
+{
+}
+
+IncidenceTransfer::~IncidenceTransfer() = default;
+
+IncidenceTransfer::Mode IncidenceTransfer::mode() const
+{
+    return mMode;
+}
+
+Akonadi::Collection IncidenceTransfer::destination() const
+{
+    return mDestination;
+}
+
+void IncidenceTransfer::start()
+{
+    if (mItems.isEmpty()) {
+        finish();
+        return;
+    }
+
+    if (mMode == Copy) {
+        // Exceptions share the UID of their series, and related incidences
+        // refer to each other by UID, so all copies use the same mapping
+        for (const Akonadi::Item &item : mItems) {
+            if (const KCalendarCore::Incidence::Ptr incidence = Akonadi::CalendarUtils::incidence(item)) {
+                if (!mCopyUids.contains(incidence->uid())) {
+                    mCopyUids.insert(incidence->uid(), KCalendarCore::CalFormat::createUniqueId());
+                }
+            }
+        }
+    }
+
+    const QString label = mMode == Copy ? i18nc("@info:progress", "Copying incidences") : i18nc("@info:progress", "Moving incidences");
+    mProgressItem = KPIM::ProgressManager::createProgressItem(KPIM::ProgressManager::getUniqueID(), label);
+    connect(mProgressItem, &KPIM::ProgressItem::progressItemCanceled, this, [this]() {
+        // The running job is not interrupted, the items it was given are
+        // either all transferred or none of them
+        mCanceled = true;
+    });
+    transferNextChunk();
+}
+
+void IncidenceTransfer::transferNextChunk()
+{
+    const int chunkStart = mChunkEnd;
+    mChunkEnd = std::min<int>(chunkStart + chunkSize, mItems.size());
+    const Akonadi::Item::List chunk = mItems.mid(chunkStart, mChunkEnd - chunkStart);
+
+    mChunkItems.clear();
+    if (mMode == Copy) {
+        copyChunk(chunk);
+    } else {
+        auto job = new Akonadi::ItemMoveJob(chunk, mDestination, this);
+        connect(job, &KJob::result, this, &IncidenceTransfer::slotChunkFinished);
+    }
+}
+
+void IncidenceTransfer::copyChunk(const Akonadi::Item::List &chunk)
+{
+    // ItemCopyJob keeps the UIDs, so the copies are created from clones instead
+    auto transaction = new Akonadi::TransactionSequence(this);
+    for (const Akonadi::Item &item : chunk) {
+        const KCalendarCore::Incidence::Ptr incidence = Akonadi::CalendarUtils::incidence(item);
+        if (!incidence) {
+            qCWarning(KORGANIZER_LOG) << "Item" << item.id() << "has no incidence, not copying it";
+            continue;
+        }
+        KCalendarCore::Incidence::Ptr copy(incidence->clone());
+        copy->setUid(mCopyUids.value(incidence->uid()));
+        const QString relatedTo = copy->relatedTo();
+        if (mCopyUids.contains(relatedTo)) {
+            copy->setRelatedTo(mCopyUids.value(relatedTo));
+        }
+
+        Akonadi::Item copyItem;
+        copyItem.setMimeType(copy->mimeType());
+        copyItem.setPayload<KCalendarCore::Incidence::Ptr>(copy);
+        auto job = new Akonadi::ItemCreateJob(copyItem, mDestination, transaction);
+        connect(job, &KJob::result, this, [this](KJob *createJob) {
+            if (!createJob->error()) {
+                mChunkItems.append(static_cast<Akonadi::ItemCreateJob *>(createJob)->item());
+            }
+        });
+    }
+    connect(transaction, &KJob::result, this, &IncidenceTransfer::slotChunkFinished);
+}
+
+void IncidenceTransfer::slotChunkFinished(KJob *job)
+{
+    if (job->error()) {
+        qCWarning(KORGANIZER_LOG) << "Transferring incidences to collection" << mDestination.id() << "failed:" << job->errorString();
+        // The chunk is transferred as a whole or not at all
+        mChunkItems.clear();
+        finish(job->errorString());
+        return;
+    }
+
+    mTransferredItems += mChunkItems;
+    mChunkItems.clear();
+
+    mTransferred = mChunkEnd;
+    if (mProgressItem) {
+        mProgressItem->setProgress(100 * mTransferred / mItems.size());
+        mProgressItem->setStatus(i18ncp("@info:progress", "%1 of %2 incidence", "%1 of %2 incidences", mTransferred, mItems.size()));
+    }
+
+    if (mCanceled || mTransferred == mItems.size()) {
+        finish();
+    } else {
+        transferNextChunk();
+    }
+}
+
+void IncidenceTransfer::recordHistory()
+{
+    // History can only undo moves by deleting the moved items and recreating
+    // the originals under new ids, so moves are not recorded at all
+    if (!mHistory || mMode == Move || mTransferredItems.isEmpty()) {
+        return;
+    }
+
+    // Atomic operation ids are handed out by IncidenceChanger, which doesn't
+    // create these items, so each copy is its own undo step
+    const QString description = i18nc("@info/plain", "Copy Incidence");
+    for (const Akonadi::Item &item : std::as_const(mTransferredItems)) {
+        mHistory->recordCreation(item, description);
+    }
+}
+
+void IncidenceTransfer::finish(const QString &errorString)
+{
+    if (mProgressItem) {
+        mProgressItem->setComplete();
+    }
+    recordHistory();
+    Q_EMIT finished(mTransferred, errorString);
+    deleteLater();
+}
+
+#include "moc_incidencetransfer.cpp"
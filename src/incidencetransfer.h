@@ -0,0 +1,103 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include <Akonadi/Collection>
+#include <Akonadi/Item>
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+
+class KJob;
+
+namespace Akonadi
+{
+class History;
+}
+
+namespace KPIM
+{
+class ProgressItem;
+}
+
+/**
+  Copies or moves incidences into another calendar.
+
+  The items are handed to Akonadi in chunks of up to chunkSize items, each
+  chunk as a single ItemMoveJob or, for copies, a single transaction,
+  instead of one change per item. Copies get new UIDs, so they don't clash
+  with their originals; relations between the copied items are kept. The
+  progress is shown in the status bar, where the transfer can also be
+  canceled; chunks already transferred stay where they are.
+
+  The copies are recorded in @p history, each as its own undo step. Moves
+  are not recorded and cannot be undone.
+
+  The transfer deletes itself when it is finished.
+
+  @short Bulk copy and move of incidences
+*/
+class IncidenceTransfer : public QObject
+{
+    Q_OBJECT
+public:
+    enum Mode {
+        Copy,
+        Move
+    };
+
+    /** the number of items transferred by a single job */
+    static constexpr int chunkSize = 1000;
+
+    IncidenceTransfer(Mode mode,
+                      const Akonadi::Item::List &items,
+                      const Akonadi::Collection &destination,
+                      Akonadi::History *history = nullptr,
+                      QObject *parent = nullptr);
+    ~IncidenceTransfer() override;
+
+    /**
+      Starts the transfer. finished() is emitted once all chunks are done,
+      the first one failed or the transfer was canceled.
+    */
+    void start();
+
+    [[nodiscard]] Mode mode() const;
+    [[nodiscard]] Akonadi::Collection destination() const;
+
+Q_SIGNALS:
+    /**
+      Emitted when the transfer stopped. @p transferred is the number of
+      items copied or moved, @p errorString is empty unless a job failed.
+    */
+    void finished(int transferred, const QString &errorString);
+
+private:
+    void transferNextChunk();
+    void copyChunk(const Akonadi::Item::List &chunk);
+    void slotChunkFinished(KJob *job);
+    void recordHistory();
+    void finish(const QString &errorString = {});
+
+    const Mode mMode;
+    const Akonadi::Item::List mItems;
+    const Akonadi::Collection mDestination;
+    QPointer<Akonadi::History> mHistory;
+    /** the UIDs of the copies, by the UIDs of the items copied */
+    QHash<QString, QString> mCopyUids;
+    /** the copies created by the running chunk */
+    Akonadi::Item::List mChunkItems;
+    /** the copies created so far */
+    Akonadi::Item::List mTransferredItems;
+    QPointer<KPIM::ProgressItem> mProgressItem;
+    int mTransferred = 0;
+    int mChunkEnd = 0;
+    bool mCanceled = false;
+};
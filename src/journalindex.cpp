@@ -0,0 +1,153 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "journalindex.h"
+
+#include <KCalendarCore/CalFilter>
+
+#include <QHash>
+
+#include <algorithm>
+
+namespace
+{
+using JournalEntry = std::pair<QDate, KCalendarCore::Journal::Ptr>;
+
+bool entryBefore(const JournalEntry &entry, QDate date)
+{
+    return entry.first < date;
+}
+
+bool dateBefore(QDate date, const JournalEntry &entry)
+{
+    return date < entry.first;
+}
+
+// Indexes currently in use, so that every user of a calendar shares its index
+QHash<const Akonadi::CollectionCalendar *, QWeakPointer<JournalIndex>> &liveIndexes()
+{
+    static QHash<const Akonadi::CollectionCalendar *, QWeakPointer<JournalIndex>> indexes;
+    return indexes;
+}
+}
+
+JournalIndex::JournalIndex(const Akonadi::CollectionCalendar::Ptr &calendar)
+    : mCalendar(calendar)
+{
+    calendar->registerObserver(this);
+}
+
+JournalIndex::~JournalIndex()
+{
+    // Calendars don't notify their observers when they go away
+    if (const auto calendar = mCalendar.toStrongRef()) {
+        calendar->unregisterObserver(this);
+        liveIndexes().remove(calendar.data());
+    }
+}
+
+JournalIndex::Ptr JournalIndex::forCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
+{
+    Q_ASSERT(calendar);
+    auto &indexes = liveIndexes();
+    const auto it = indexes.constFind(calendar.data());
+    if (it != indexes.cend()) {
+        // The address may belong to a calendar which was deleted in the meantime
+        const Ptr index = it->toStrongRef();
+        if (index && index->mCalendar.toStrongRef() == calendar) {
+            return index;
+        }
+    }
+
+    indexes.removeIf([](const auto &entry) {
+        return entry.value().isNull();
+    });
+    const Ptr index(new JournalIndex(calendar));
+    indexes.insert(calendar.data(), index);
+    return index;
+}
+
+KCalendarCore::Journal::List JournalIndex::rawJournals(QDate start, QDate end) const
+{
+    KCalendarCore::Journal::List result;
+    if (!start.isValid() || !end.isValid() || end < start) {
+        return result;
+    }
+
+    ensureBuilt();
+    const auto first = std::lower_bound(mJournals.cbegin(), mJournals.cend(), start, entryBefore);
+    const auto last = std::upper_bound(first, mJournals.cend(), end, dateBefore);
+    result.reserve(std::distance(first, last));
+    for (auto it = first; it != last; ++it) {
+        result.append(it->second);
+    }
+    return result;
+}
+
+KCalendarCore::Journal::List JournalIndex::journals(QDate start, QDate end) const
+{
+    KCalendarCore::Journal::List result = rawJournals(start, end);
+    const auto calendar = mCalendar.toStrongRef();
+    if (calendar && calendar->filter()) {
+        calendar->filter()->apply(&result);
+    }
+    return result;
+}
+
+void JournalIndex::calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    invalidate(incidence);
+}
+
+void JournalIndex::calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    invalidate(incidence);
+}
+
+void JournalIndex::calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar)
+{
+    Q_UNUSED(calendar)
+    invalidate(incidence);
+}
+
+void JournalIndex::invalidate(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    if (incidence && incidence->type() == KCalendarCore::Incidence::TypeJournal) {
+        mDirty = true;
+    }
+}
+
+void JournalIndex::ensureBuilt() const
+{
+    if (!mDirty) {
+        return;
+    }
+    mDirty = false;
+    mJournals.clear();
+
+    const auto calendar = mCalendar.toStrongRef();
+    if (!calendar) {
+        return;
+    }
+
+    // Bucket the journals the same way MemoryCalendar::rawJournalsForDate() does
+    const QTimeZone timeZone = calendar->timeZone();
+    const KCalendarCore::Journal::List journals = calendar->rawJournals();
+    mJournals.reserve(journals.size());
+    for (const KCalendarCore::Journal::Ptr &journal : journals) {
+        const QDateTime dtStart = journal->dtStart();
+        if (!dtStart.isValid()) {
+            continue;
+        }
+        const QDate date = journal->allDay() ? dtStart.date() : dtStart.toTimeZone(timeZone).date();
+        mJournals.append({date, journal});
+    }
+    std::stable_sort(mJournals.begin(), mJournals.end(), [](const JournalEntry &lhs, const JournalEntry &rhs) {
+        return lhs.first < rhs.first;
+    });
+}
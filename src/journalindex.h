@@ -0,0 +1,80 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "korganizerprivate_export.h"
+
+#include <Akonadi/CollectionCalendar>
+
+#include <KCalendarCore/Journal>
+
+#include <QDate>
+#include <QList>
+#include <QSharedPointer>
+#include <QWeakPointer>
+
+#include <utility>
+
+/**
+  Journals of a calendar sorted by the day they were written on.
+
+  The index observes its calendar and is rebuilt lazily on the first query
+  after a journal was added, changed or removed. Looking up the journals of
+  a date range then costs a binary search plus the number of results, instead
+  of one calendar lookup per day.
+
+  All users of a calendar share the same index, see forCalendar().
+
+  @short Date range lookup of journals
+*/
+class KORGANIZERPRIVATE_EXPORT JournalIndex : public KCalendarCore::Calendar::CalendarObserver
+{
+public:
+    using Ptr = QSharedPointer<JournalIndex>;
+
+    /**
+      Returns the index of @p calendar. The index is created if nobody else
+      holds it at the moment.
+    */
+    [[nodiscard]] static Ptr forCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
+
+    ~JournalIndex() override;
+
+    /**
+      Returns the journals whose start date, in the time zone of the calendar,
+      lies within [@p start, @p end]. Equivalent to calling
+      Calendar::rawJournalsForDate() for each day of the range.
+    */
+    [[nodiscard]] KCalendarCore::Journal::List rawJournals(QDate start, QDate end) const;
+
+    /**
+      Same as rawJournals(), with the filter of the calendar applied.
+    */
+    [[nodiscard]] KCalendarCore::Journal::List journals(QDate start, QDate end) const;
+
+protected:
+    /**
+     *  Reimplemented from KCalendarCore::Calendar::CalendarObserver
+     */
+    void calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar) override;
+
+private:
+    explicit JournalIndex(const Akonadi::CollectionCalendar::Ptr &calendar);
+
+    void invalidate(const KCalendarCore::Incidence::Ptr &incidence);
+    void ensureBuilt() const;
+
+    const QWeakPointer<Akonadi::CollectionCalendar> mCalendar;
+
+    /** journals of the calendar, sorted by date */
+    mutable QList<std::pair<QDate, KCalendarCore::Journal::Ptr>> mJournals;
+    mutable bool mDirty = true;
+};
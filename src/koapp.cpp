@@ -13,6 +13,7 @@
 #include "calendarview.h"
 #include "korganizer-version.h"
 #include "korganizer.h"
+#include "startuptrace.h"
 
 #include <KCalendarCore/CalFormat>
 
@@ -29,12 +30,17 @@
 KOrganizerApp::KOrganizerApp(int &argc, char **argv[])
     : KontactInterface::PimUniqueApplication(argc, argv)
 {
-    const QString prodId = QStringLiteral("-//K Desktop Environment//NONSGML KOrganizer %1//EN");
-    KCalendarCore::CalFormat::setApplication(QStringLiteral("KOrganizer"), prodId.arg(QStringLiteral(KORGANIZER_VERSION)));
+    setProductId();
 }
 
 KOrganizerApp::~KOrganizerApp() = default;
 
+void KOrganizerApp::setProductId()
+{
+    const QString prodId = QStringLiteral("-//K Desktop Environment//NONSGML KOrganizer %1//EN");
+    KCalendarCore::CalFormat::setApplication(QStringLiteral("KOrganizer"), prodId.arg(QStringLiteral(KORGANIZER_VERSION)));
+}
+
 int KOrganizerApp::activate(const QStringList &args, const QString &workingDir)
 {
     Q_UNUSED(workingDir)
@@ -90,16 +96,15 @@ int KOrganizerApp::activate(const QStringList &args, const QString &workingDir)
         return -1;
     }
     // Check for import, merge or ask
-    if (parser.isSet(QStringLiteral("import"))) {
+    if (parser.isSet(QStringLiteral("import")) || parser.isSet(QStringLiteral("merge"))) {
         const auto lst = parser.positionalArguments();
+        QList<QUrl> urls;
+        urls.reserve(lst.size());
         for (const QString &url : lst) {
-            korg->actionManager()->importURL(QUrl::fromUserInput(url), false);
-        }
-    } else if (parser.isSet(QStringLiteral("merge"))) {
-        const auto lst = parser.positionalArguments();
-        for (const QString &url : lst) {
-            korg->actionManager()->importURL(QUrl::fromUserInput(url), true);
+            urls.append(QUrl::fromUserInput(url));
         }
+        // Import wins if both are given, as in ActionManager::handleCommandLine()
+        korg->actionManager()->importURLs(urls, !parser.isSet(QStringLiteral("import")));
     } else {
         const auto lst = parser.positionalArguments();
         for (const QString &url : lst) {
@@ -115,8 +120,11 @@ void KOrganizerApp::processCalendar(const QUrl &url, bool show)
     KOrg::MainWindow *korg = ActionManager::findInstance(url);
     if (!korg) {
         const bool hasDocument = !url.isEmpty();
-        korg = new KOrganizer();
-        korg->init(hasDocument);
+        {
+            KOrg::StartupTrace::Phase phase("main window");
+            korg = new KOrganizer();
+            korg->init(hasDocument);
+        }
         if (show) {
             korg->topLevelWidget()->show();
         }
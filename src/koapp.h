@@ -20,6 +20,11 @@ public:
     KOrganizerApp(int &argc, char **argv[]);
     ~KOrganizerApp() override;
 
+    /**
+      Sets the product id written into the iCalendar and vCalendar files.
+    */
+    static void setProductId();
+
 protected:
     /**
       Create new instance of KOrganizer. If there is already running a
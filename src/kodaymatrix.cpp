@@ -34,7 +34,6 @@
 // ============================================================================
 
 const int KODayMatrix::NOSELECTION = -1000;
-const int KODayMatrix::NUMDAYS = 42;
 
 KODayMatrix::KODayMatrix(QWidget *parent)
     : QFrame(parent)
@@ -47,28 +46,26 @@ KODayMatrix::KODayMatrix(QWidget *parent)
     mSelEnd = mSelStart = NOSELECTION;
 
     recalculateToday();
-
-    mHighlightEvents = true;
-    mHighlightTodos = false;
-    mHighlightJournals = false;
-}
-
-void KODayMatrix::addCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
-{
-    calendar->registerObserver(this);
-    mCalendars.push_back(calendar);
-
-    setAcceptDrops(true);
-    updateIncidences();
 }
 
-void KODayMatrix::removeCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
+void KODayMatrix::setDayOccupancy(DayOccupancy *occupancy)
 {
-    calendar->unregisterObserver(this);
-    mCalendars.removeOne(calendar);
-
-    setAcceptDrops(!mCalendars.empty());
-    updateIncidences();
+    if (mOccupancy) {
+        mOccupancy->removeRange(this);
+        disconnect(mOccupancy, nullptr, this, nullptr);
+    }
+    mOccupancy = occupancy;
+    if (mOccupancy) {
+        connect(mOccupancy, &DayOccupancy::changed, this, [this]() {
+            setAcceptDrops(mOccupancy->hasCalendars());
+            update();
+        });
+        if (mStartDate.isValid()) {
+            mOccupancy->setRange(this, mDays[0], mDays[NUMDAYS - 1]);
+        }
+    }
+    setAcceptDrops(mOccupancy && mOccupancy->hasCalendars());
+    update();
 }
 
 QColor KODayMatrix::getShadedColor(const QColor &color) const
@@ -87,8 +84,8 @@ QColor KODayMatrix::getShadedColor(const QColor &color) const
 
 KODayMatrix::~KODayMatrix()
 {
-    for (const auto &calendar : std::as_const(mCalendars)) {
-        calendar->unregisterObserver(this);
+    if (mOccupancy) {
+        mOccupancy->removeRange(this);
     }
 
     delete[] mDays;
@@ -114,6 +111,7 @@ void KODayMatrix::recalculateToday()
         return;
     }
 
+    const int oldToday = mToday;
     mToday = -1;
     for (int i = 0; i < NUMDAYS; ++i) {
         mDays[i] = mStartDate.addDays(i);
@@ -125,6 +123,10 @@ void KODayMatrix::recalculateToday()
             mToday = i;
         }
     }
+
+    if (mToday != oldToday) {
+        update(daysRegion(oldToday, oldToday) + daysRegion(mToday, mToday));
+    }
 }
 
 void KODayMatrix::updateView()
@@ -134,7 +136,11 @@ void KODayMatrix::updateView()
 
 void KODayMatrix::setUpdateNeeded()
 {
+    // The occupancy follows the calendars by itself; only calendar and
+    // configuration changes rebuild it
     mPendingChanges = true;
+    invalidateStaticLayer();
+    update();
 }
 
 void KODayMatrix::updateView(QDate actdate)
@@ -175,15 +181,18 @@ void KODayMatrix::updateView(QDate actdate)
     }
 
     // The calendar has not changed in the meantime and the selected range
-    // is still the same so we can save the expensive updateIncidences() call
+    // is still the same so we can save looking up the holidays again
     if (!daychanged && !mPendingChanges) {
         return;
     }
 
-    // TODO_Recurrence: If we just change the selection, but not the data,
-    // there's no need to update the whole list of incidences… This is just a
-    // waste of computational power
-    updateIncidences();
+    // The occupancy itself is only rebuilt when it is queried for painting,
+    // once for all day matrices
+    if (mOccupancy) {
+        mOccupancy->setRange(this, mDays[0], mDays[NUMDAYS - 1]);
+    }
+    mPendingChanges = false;
+    invalidateStaticLayer();
     QMap<QDate, QStringList> holidaysByDate = KOGlobals::self()->holiday(mDays[0], mDays[NUMDAYS - 1]);
     for (int i = 0; i < NUMDAYS; ++i) {
         // if it is a holy day then draw it red. Sundays are consider holidays, too
@@ -200,156 +209,12 @@ void KODayMatrix::updateView(QDate actdate)
     }
 }
 
-void KODayMatrix::updateIncidences()
-{
-    mEvents.clear();
-
-    if (mHighlightEvents) {
-        updateEvents();
-    }
-
-    if (mHighlightTodos) {
-        updateTodos();
-    }
-
-    if (mHighlightJournals) {
-        updateJournals();
-    }
-
-    mPendingChanges = false;
-}
-
-void KODayMatrix::updateJournals()
-{
-    for (const auto &calendar : std::as_const(mCalendars)) {
-        const KCalendarCore::Incidence::List incidences = calendar->incidences();
-        for (const KCalendarCore::Incidence::Ptr &inc : incidences) {
-            Q_ASSERT(inc);
-            QDate const d = inc->dtStart().toLocalTime().date();
-            if (inc->type() == KCalendarCore::Incidence::TypeJournal && d >= mDays[0] && d <= mDays[NUMDAYS - 1] && !mEvents.contains(d)) {
-                mEvents.append(d);
-            }
-            if (mEvents.count() == NUMDAYS) {
-                // No point in wasting cpu, all days are bold already
-                break;
-            }
-        }
-    }
-}
-
-/**
- * Although updateTodos() is simpler it has some similarities with updateEvent()
- * but don't bother refactoring them so they share code, there's a bigger fish:
- * Try to refactor updateTodos(), updateEvent(), updateJournals(), monthview,
- * agenda view, timeline view, event list view and todo list view
- * all these 9 places have incidence listing code in common, maybe it could go
- * to kcal. Ah, and then there's kontact's summary view which still uses
- * the old CPU consuming code.
- */
-void KODayMatrix::updateTodos()
-{
-    QDate d;
-    for (const auto &calendar : std::as_const(mCalendars)) {
-        const KCalendarCore::Todo::List todos = calendar->todos();
-        for (const KCalendarCore::Todo::Ptr &t : todos) {
-            if (mEvents.count() == NUMDAYS) {
-                // No point in wasting cpu, all days are bold already
-                break;
-            }
-            Q_ASSERT(t);
-            if (t->hasDueDate()) {
-                ushort const recurType = t->recurrenceType();
-
-                if (t->recurs() && !(recurType == KCalendarCore::Recurrence::rDaily && !KOPrefs::instance()->mDailyRecur)
-                    && !(recurType == KCalendarCore::Recurrence::rWeekly && !KOPrefs::instance()->mWeeklyRecur)) {
-                    // It's a recurring todo, find out in which days it occurs
-                    const auto timeDateList = t->recurrence()->timesInInterval(QDateTime(mDays[0], {}, QTimeZone::LocalTime),
-                                                                               QDateTime(mDays[NUMDAYS - 1], {}, QTimeZone::LocalTime));
-
-                    for (const QDateTime &dt : timeDateList) {
-                        d = dt.toLocalTime().date();
-                        if (!mEvents.contains(d)) {
-                            mEvents.append(d);
-                        }
-                    }
-                } else {
-                    d = t->dtDue().toLocalTime().date();
-                    if (d >= mDays[0] && d <= mDays[NUMDAYS - 1] && !mEvents.contains(d)) {
-                        mEvents.append(d);
-                    }
-                }
-            }
-        }
-    }
-}
-
-void KODayMatrix::updateEvents()
+bool KODayMatrix::dayHasIncidences(int offset) const
 {
-    if (mEvents.count() == NUMDAYS) {
-        mPendingChanges = false;
-        // No point in wasting cpu, all days are bold already
-        return;
-    }
-
-    for (const auto &calendar : std::as_const(mCalendars)) {
-        const auto eventlist = calendar->events(mDays[0], mDays[NUMDAYS - 1], calendar->timeZone());
-        for (const KCalendarCore::Event::Ptr &ev : eventlist) {
-            if (mEvents.count() == NUMDAYS) {
-                // No point in wasting cpu, all days are bold already
-                break;
-            }
-
-            Q_ASSERT(ev);
-            const ushort recurType = ev->recurrenceType();
-            const QDateTime dtStart = ev->dtStart().toLocalTime();
-
-            // timed incidences occur in
-            //   [dtStart(), dtEnd()[. All-day incidences occur in [dtStart(), dtEnd()]
-            // so we subtract 1 second in the timed case
-            const int secsToAdd = ev->allDay() ? 0 : -1;
-            const QDateTime dtEnd = ev->dtEnd().toLocalTime().addSecs(secsToAdd);
-
-            if (!(recurType == KCalendarCore::Recurrence::rDaily && !KOPrefs::instance()->mDailyRecur)
-                && !(recurType == KCalendarCore::Recurrence::rWeekly && !KOPrefs::instance()->mWeeklyRecur)) {
-                KCalendarCore::DateTimeList timeDateList;
-                const bool isRecurrent = ev->recurs();
-                const int eventDuration = dtStart.daysTo(dtEnd);
-
-                if (isRecurrent) {
-                    // Its a recurring event, find out in which days it occurs
-                    timeDateList = ev->recurrence()->timesInInterval(QDateTime(mDays[0], {}, QTimeZone::LocalTime),
-                                                                     QDateTime(mDays[NUMDAYS - 1], {}, QTimeZone::LocalTime));
-                } else {
-                    if (dtStart.date() >= mDays[0]) {
-                        timeDateList.append(dtStart);
-                    } else {
-                        // The event starts in another month (not visible))
-                        timeDateList.append(QDateTime(mDays[0], {}, QTimeZone::LocalTime));
-                    }
-                }
-
-                for (auto t = timeDateList.begin(); t != timeDateList.end(); ++t) {
-                    // This could be a multiday event, so iterate from dtStart() to dtEnd()
-                    QDate d = t->toLocalTime().date();
-                    int j = 0;
-
-                    QDate occurrenceEnd;
-                    if (isRecurrent) {
-                        occurrenceEnd = d.addDays(eventDuration);
-                    } else {
-                        occurrenceEnd = dtEnd.date();
-                    }
-
-                    do {
-                        mEvents.append(d);
-                        ++j;
-                        d = d.addDays(1);
-                    } while (d <= occurrenceEnd && j < NUMDAYS);
-                }
-            }
-        }
-        mPendingChanges = false;
+    if (offset < 0 || offset > NUMDAYS - 1) {
+        return false;
     }
+    return mOccupancy && mOccupancy->isOccupied(mDays[offset]);
 }
 
 const QDate &KODayMatrix::getDate(int offset) const
@@ -373,39 +238,12 @@ int KODayMatrix::getDayIndexFrom(int x, int y) const
     return 7 * (y / mDaySize.height()) + (KOGlobals::self()->reverseLayout() ? 6 - x / mDaySize.width() : x / mDaySize.width());
 }
 
-void KODayMatrix::calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence)
-{
-    Q_UNUSED(incidence)
-    mPendingChanges = true;
-}
-
-void KODayMatrix::calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence)
-{
-    Q_UNUSED(incidence)
-    mPendingChanges = true;
-}
-
-void KODayMatrix::calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar)
-{
-    Q_UNUSED(incidence)
-    Q_UNUSED(calendar)
-    mPendingChanges = true;
-}
-
-void KODayMatrix::setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals)
-{
-    // don't set mPendingChanges to true if nothing changed
-    if (highlightTodos != mHighlightTodos || highlightEvents != mHighlightEvents || highlightJournals != mHighlightJournals) {
-        mHighlightEvents = highlightEvents;
-        mHighlightTodos = highlightTodos;
-        mHighlightJournals = highlightJournals;
-        mPendingChanges = true;
-    }
-}
-
 void KODayMatrix::resourcesChanged()
 {
-    mPendingChanges = true;
+    if (mOccupancy) {
+        mOccupancy->setUpdateNeeded();
+    }
+    setUpdateNeeded();
 }
 
 // ----------------------------------------------------------------------------
@@ -474,22 +312,18 @@ void KODayMatrix::mouseReleaseEvent(QMouseEvent *e)
         tmp = NUMDAYS - 1;
     }
 
+    const int oldSelStart = mSelStart;
+    const int oldSelEnd = mSelEnd;
     if (mSelInit > tmp) {
         mSelEnd = mSelInit;
-        if (tmp != mSelStart) {
-            mSelStart = tmp;
-            update();
-        }
+        mSelStart = tmp;
     } else {
         mSelStart = mSelInit;
-
-        // repaint only if selection has changed
-        if (tmp != mSelEnd) {
-            mSelEnd = tmp;
-            update();
-        }
+        mSelEnd = tmp;
     }
 
+    updateChangedSelection(oldSelStart, oldSelEnd);
+
     KCalendarCore::DateList daylist;
     if (mSelStart < 0) {
         mSelStart = 0;
@@ -508,21 +342,17 @@ void KODayMatrix::mouseMoveEvent(QMouseEvent *e)
         tmp = NUMDAYS - 1;
     }
 
+    const int oldSelStart = mSelStart;
+    const int oldSelEnd = mSelEnd;
     if (mSelInit > tmp) {
         mSelEnd = mSelInit;
-        if (tmp != mSelStart) {
-            mSelStart = tmp;
-            update();
-        }
+        mSelStart = tmp;
     } else {
         mSelStart = mSelInit;
-
-        // repaint only if selection has changed
-        if (tmp != mSelEnd) {
-            mSelEnd = tmp;
-            update();
-        }
+        mSelEnd = tmp;
     }
+
+    updateChangedSelection(oldSelStart, oldSelEnd);
 }
 
 // ----------------------------------------------------------------------------
@@ -639,24 +469,22 @@ void KODayMatrix::dropEvent(QDropEvent *e)
 
 void KODayMatrix::paintEvent(QPaintEvent *)
 {
-    QPainter p;
-    const QRect rect = frameRect();
+    const quint64 revision = mOccupancy ? mOccupancy->revision() : 0;
+    if (mStaticLayer.isNull() || mStaticLayer.devicePixelRatio() != devicePixelRatioF() || revision != mStaticLayerRevision) {
+        mStaticLayerRevision = revision;
+        renderStaticLayer();
+    }
+
+    QPainter p(this);
     const int dayHeight = mDaySize.height();
     const int dayWidth = mDaySize.width();
     int row;
     int column;
     const bool isRTL = KOGlobals::self()->reverseLayout();
 
-    QPalette const pal = palette();
-
-    p.begin(this);
+    // only the parts of the layer in the update region are copied
+    p.drawPixmap(0, 0, mStaticLayer);
 
-    // draw background
-    p.fillRect(0, 0, rect.width(), rect.height(), QBrush(pal.color(QPalette::Base)));
-
-    // draw topleft frame
-    p.setPen(pal.color(QPalette::Mid));
-    p.drawRect(0, 0, rect.width() - 1, rect.height() - 1);
     // don't paint over borders
     p.translate(1, 1);
 
@@ -700,98 +528,112 @@ void KODayMatrix::paintEvent(QPaintEvent *)
                 }
             }
         }
-    }
-
-    // iterate over all days in the matrix and draw the day label in appropriate colors
-    const QColor textColor = pal.color(QPalette::Text);
-    const QColor textColorShaded = getShadedColor(textColor);
-    QColor actcol = textColorShaded;
-    p.setPen(actcol);
-    QPen tmppen;
-
-    const QList<QDate> workDays = CalendarSupport::workDays(mDays[0], mDays[NUMDAYS - 1]);
-    for (int i = 0; i < NUMDAYS; ++i) {
-        row = i / 7;
-        column = isRTL ? 6 - (i - row * 7) : i - row * 7;
 
-        // if it is the first day of a month switch color from normal to shaded and vice versa
-        if (mDays[i].day() == 1) {
-            if (actcol == textColorShaded) {
-                actcol = textColor;
-            } else {
-                actcol = textColorShaded;
-            }
-            p.setPen(actcol);
+        // the selection covered the labels of the layer, draw selected days with special color
+        for (int i = std::max(mSelStart, 0); i <= std::min(mSelEnd, NUMDAYS - 1); ++i) {
+            drawDayLabel(p, i, mNonWorkingDays[i] ? dayColor(i) : QColor(Qt::white));
         }
+    }
 
-        // Reset pen color after selected days block
-        if (i == mSelEnd + 1) {
-            p.setPen(actcol);
+    // if today then draw rectangle around day
+    if (mToday >= 0 && mToday < NUMDAYS) {
+        QPen todayPen(dayColor(mToday));
+        todayPen.setWidth(mTodayMarginWidth);
+        // draw gray rectangle for today if in selection
+        if (mToday >= mSelStart && mToday <= mSelEnd) {
+            todayPen.setColor(QColor(QStringLiteral("grey")));
         }
+        p.setPen(todayPen);
+        p.drawRect(dayRect(mToday));
+    }
+}
 
-        const bool holiday = !workDays.contains(mDays[i]);
+void KODayMatrix::renderStaticLayer()
+{
+    const qreal dpr = devicePixelRatioF();
+    mStaticLayer = QPixmap(size() * dpr);
+    mStaticLayer.setDevicePixelRatio(dpr);
 
-        const QColor holidayColorShaded = getShadedColor(KOPrefs::instance()->agendaHolidaysBackgroundColor());
+    QPainter p(&mStaticLayer);
+    const QRect rect = frameRect();
+    QPalette const pal = palette();
 
-        // if today then draw rectangle around day
-        if (mToday == i) {
-            tmppen = p.pen();
-            QPen todayPen(p.pen());
+    // draw background
+    p.fillRect(0, 0, rect.width(), rect.height(), QBrush(pal.color(QPalette::Base)));
 
-            todayPen.setWidth(mTodayMarginWidth);
-            // draw red rectangle for holidays
-            if (holiday) {
-                if (actcol == textColor) {
-                    todayPen.setColor(KOPrefs::instance()->agendaHolidaysBackgroundColor());
-                } else {
-                    todayPen.setColor(holidayColorShaded);
-                }
-            }
-            // draw gray rectangle for today if in selection
-            if (i >= mSelStart && i <= mSelEnd) {
-                const QColor grey(QStringLiteral("grey"));
-                todayPen.setColor(grey);
-            }
-            p.setPen(todayPen);
-            p.drawRect(column * dayWidth, row * dayHeight, dayWidth, dayHeight);
-            p.setPen(tmppen);
-        }
+    // draw topleft frame
+    p.setPen(pal.color(QPalette::Mid));
+    p.drawRect(0, 0, rect.width() - 1, rect.height() - 1);
+    // don't paint over borders
+    p.translate(1, 1);
 
-        // if any events are on that day then draw it using a bold font
-        if (mEvents.contains(mDays[i])) {
-            QFont myFont = font();
-            myFont.setBold(true);
-            p.setFont(myFont);
+    // iterate over all days in the matrix and draw the day label in appropriate colors
+    const QList<QDate> workDays = CalendarSupport::workDays(mDays[0], mDays[NUMDAYS - 1]);
+    bool shaded = true;
+    for (int i = 0; i < NUMDAYS; ++i) {
+        // if it is the first day of a month switch color from normal to shaded and vice versa
+        if (mDays[i].day() == 1) {
+            shaded = !shaded;
         }
+        mShadedDays[i] = shaded;
+        mNonWorkingDays[i] = !workDays.contains(mDays[i]);
+        // if any events are on that day then draw it using a bold font
+        mOccupiedDays[i] = dayHasIncidences(i);
 
-        // if it is a holiday then use the default holiday color
-        if (holiday) {
-            if (actcol == textColor) {
-                p.setPen(KOPrefs::instance()->agendaHolidaysBackgroundColor());
-            } else {
-                p.setPen(holidayColorShaded);
-            }
-        }
+        drawDayLabel(p, i, dayColor(i));
+    }
+}
 
-        // draw selected days with special color
-        if (i >= mSelStart && i <= mSelEnd && !holiday) {
-            p.setPen(Qt::white);
-        }
+void KODayMatrix::invalidateStaticLayer()
+{
+    mStaticLayer = QPixmap();
+}
+
+QRect KODayMatrix::dayRect(int index) const
+{
+    const int row = index / 7;
+    const int column = KOGlobals::self()->reverseLayout() ? 6 - (index - row * 7) : index - row * 7;
+    return {column * mDaySize.width(), row * mDaySize.height(), mDaySize.width(), mDaySize.height()};
+}
 
-        p.drawText(column * dayWidth, row * dayHeight, dayWidth, dayHeight, Qt::AlignHCenter | Qt::AlignVCenter, mDayLabels[i]);
+QRegion KODayMatrix::daysRegion(int first, int last) const
+{
+    QRegion region;
+    for (int i = std::max(first, 0); i <= std::min(last, NUMDAYS - 1); ++i) {
+        // the frame around today is drawn centered on the edges of the day
+        region += dayRect(i).translated(1, 1).adjusted(-mTodayMarginWidth, -mTodayMarginWidth, mTodayMarginWidth, mTodayMarginWidth);
+    }
+    return region;
+}
 
-        // reset color to actual color
-        if (holiday) {
-            p.setPen(actcol);
-        }
-        // reset bold font to plain font
-        if (mEvents.contains(mDays[i])) {
-            QFont myFont = font();
-            myFont.setBold(false);
-            p.setFont(myFont);
+void KODayMatrix::updateChangedSelection(int oldSelStart, int oldSelEnd)
+{
+    // repaint only the days whose selection has changed
+    QRegion changed;
+    for (int i = 0; i < NUMDAYS; ++i) {
+        if ((i >= oldSelStart && i <= oldSelEnd) != (i >= mSelStart && i <= mSelEnd)) {
+            changed += daysRegion(i, i);
         }
     }
-    p.end();
+    if (!changed.isEmpty()) {
+        update(changed);
+    }
+}
+
+QColor KODayMatrix::dayColor(int index) const
+{
+    // if it is a holiday then use the default holiday color
+    const QColor color = mNonWorkingDays[index] ? KOPrefs::instance()->agendaHolidaysBackgroundColor() : palette().color(QPalette::Text);
+    return mShadedDays[index] ? getShadedColor(color) : color;
+}
+
+void KODayMatrix::drawDayLabel(QPainter &p, int index, const QColor &color) const
+{
+    QFont labelFont = font();
+    labelFont.setBold(mOccupiedDays[index]);
+    p.setFont(labelFont);
+    p.setPen(color);
+    p.drawText(dayRect(index), Qt::AlignHCenter | Qt::AlignVCenter, mDayLabels[index]);
 }
 
 // ----------------------------------------------------------------------------
@@ -803,6 +645,22 @@ void KODayMatrix::resizeEvent(QResizeEvent *)
     QRect const sz = frameRect();
     mDaySize.setHeight(sz.height() * 7 / NUMDAYS);
     mDaySize.setWidth(sz.width() / 7);
+    invalidateStaticLayer();
+}
+
+void KODayMatrix::changeEvent(QEvent *e)
+{
+    switch (e->type()) {
+    case QEvent::PaletteChange:
+    case QEvent::FontChange:
+    case QEvent::StyleChange:
+    case QEvent::LayoutDirectionChange:
+        invalidateStaticLayer();
+        break;
+    default:
+        break;
+    }
+    QFrame::changeEvent(e);
 }
 
 /* static */
@@ -10,12 +10,18 @@
 
 #pragma once
 
-#include <Akonadi/CollectionCalendar>
+#include "dayoccupancy.h"
 
 #include <KCalendarCore/IncidenceBase> //for KCalendarCore::DateList typedef
 
 #include <QDate>
 #include <QFrame>
+#include <QPixmap>
+#include <QPointer>
+
+#include <bitset>
+
+class QPainter;
 
 /**
  *  Replacement for kdpdatebuton.cpp that used 42 widgets for the day
@@ -50,7 +56,7 @@
  *
  *  @author Eitzenberger Thomas
  */
-class KODayMatrix : public QFrame, public KCalendarCore::Calendar::CalendarObserver
+class KODayMatrix : public QFrame
 {
     Q_OBJECT
 public:
@@ -80,11 +86,11 @@ public:
     [[nodiscard]] static MatrixRange matrixLimits(QDate month);
 
     /**
-      Associate a calendar with this day matrix. If there is a calendar, the
-      day matrix will accept drops and days with events will be highlighted.
+      Highlights the days with incidences known to @p occupancy, which is
+      shared with the other day matrices. If it has a calendar, the day
+      matrix will accept drops.
     */
-    void addCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
-    void removeCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
+    void setDayOccupancy(DayOccupancy *occupancy);
 
     /** updates the day matrix to start with the given date. Does all the
      *  necessary checks for holidays or events on a day and stores them
@@ -97,10 +103,10 @@ public:
     void updateView(QDate actdate);
 
     /**
-      Update incidence states of dates. Depending of the preferences days with
-      incidences are highlighted in some way.
-    */
-    void updateIncidences();
+     * Returns true if the day indexed by the supplied offset has at least one
+     * highlighted incidence.
+     */
+    [[nodiscard]] bool dayHasIncidences(int offset) const;
 
     /**
      * Returns the QDate object associated with day indexed by the supplied
@@ -128,16 +134,6 @@ public:
     */
     void clearSelection();
 
-    /**
-     *  Reimplemented from Akonadi::ETMCalendar
-     *  They set mPendingChanges to true
-     */
-    void calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence) override;
-    void calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence) override;
-    void calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar) override;
-
-    /** Sets which incidences should be highlighted */
-    void setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals);
     void setUpdateNeeded();
 public Q_SLOTS:
     /**
@@ -193,6 +189,8 @@ protected:
 
     void paintEvent(QPaintEvent *ev) override;
 
+    void changeEvent(QEvent *e) override;
+
     void mousePressEvent(QMouseEvent *e) override;
 
     void mouseReleaseEvent(QMouseEvent *e) override;
@@ -229,21 +227,37 @@ private:
      */
     QColor getShadedColor(const QColor &color) const;
 
-    /** updates mEvent list with all days that have events */
-    void updateEvents();
+    /** returns the rectangle of the day with the given index, in widget coordinates. */
+    [[nodiscard]] QRect dayRect(int index) const;
+
+    /** returns the area to repaint when the days from @p first to @p last
+        change, including the frame drawn around today. */
+    [[nodiscard]] QRegion daysRegion(int first, int last) const;
+
+    /** schedules a repaint of the days whose selection changed from
+        @p oldSelStart and @p oldSelEnd to the current selection. */
+    void updateChangedSelection(int oldSelStart, int oldSelEnd);
 
-    /** updates mEvent list with all days that have to-dos with due date */
-    void updateTodos();
+    /** returns the color of the label of the day with the given index when
+        it is not selected. */
+    [[nodiscard]] QColor dayColor(int index) const;
 
-    /** updates mEvent list with all days that have journals */
-    void updateJournals();
+    /** draws the label of the day with the given index in @p color. */
+    void drawDayLabel(QPainter &p, int index, const QColor &color) const;
+
+    /** draws everything which does not depend on the selection or on today
+        into mStaticLayer. */
+    void renderStaticLayer();
+
+    /** drops mStaticLayer, e.g. because the days or the preferences changed. */
+    void invalidateStaticLayer();
 
     /** number of days to be displayed. For now there is no support for any
         other number than 42. so change it at your own risk :o) */
-    static const int NUMDAYS;
+    static constexpr int NUMDAYS = 42;
 
-    /** calendar instance to be queried for holidays, events, … */
-    QList<Akonadi::CollectionCalendar::Ptr> mCalendars;
+    /** the days with highlighted incidences, shared by all day matrices */
+    QPointer<DayOccupancy> mOccupancy;
 
     /** starting date of the matrix */
     QDate mStartDate;
@@ -255,14 +269,11 @@ private:
         subsequently calling QDate::addDays(). */
     QDate *mDays = nullptr;
 
-    /** List for storing days which should be drawn using bold font. */
-    QList<QDate> mEvents;
-
     /** stores holiday names of the days shown in the matrix. */
     QMap<int, QString> mHolidays;
 
     /** index of today or -1 if today is not visible in the matrix. */
-    int mToday;
+    int mToday = -1;
 
     /** index of day where dragged selection was initiated.
         used to detect "negative" timely selections */
@@ -288,16 +299,27 @@ private:
     QRect mDaySize;
 
     /**
-     * Indicate pending calendar changes.
+     * Background, frame and day labels as of the last paint. The selection
+     * and today are drawn over it, so that moving them only repaints the
+     * days involved.
      */
-    bool mPendingChanges = false;
+    QPixmap mStaticLayer;
+
+    /** the revision of the occupancy mStaticLayer was rendered with */
+    quint64 mStaticLayerRevision = 0;
 
-    /** Whether days with events are highlighted */
-    bool mHighlightEvents = false;
+    /** the days drawn in the shaded color of the adjacent months */
+    std::bitset<NUMDAYS> mShadedDays;
 
-    /** Whether days with to-dos (with due date) are highlighted */
-    bool mHighlightTodos = false;
+    /** the days drawn in the holiday color */
+    std::bitset<NUMDAYS> mNonWorkingDays;
 
-    /** Whether days with journals are highlighted */
-    bool mHighlightJournals = false;
+    /** the days drawn using bold font */
+    std::bitset<NUMDAYS> mOccupiedDays;
+
+    /**
+     * Indicate that the holidays must be looked up again and the occupancy
+     * rebuilt, e.g. because calendars or preferences changed.
+     */
+    bool mPendingChanges = false;
 };
@@ -15,6 +15,34 @@
 #include <KHolidays/HolidayRegion>
 
 #include <QApplication>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
+#include <utility>
+
+namespace
+{
+// rawHolidaysWithAstroSeasons() returns the holidays observed in the
+// requested range, so a year holds all the holidays observed in it
+QMap<QDate, QStringList> computeHolidayYear(const QList<KHolidays::HolidayRegion *> &regions, const QStringList &categories, int year)
+{
+    QMap<QDate, QStringList> holidaysByDate;
+    for (KHolidays::HolidayRegion *region : regions) {
+        if (region && region->isValid()) {
+            region->setCategories(categories);
+            const KHolidays::Holiday::List list = region->rawHolidaysWithAstroSeasons(QDate(year, 1, 1), QDate(year, 12, 31));
+            for (const KHolidays::Holiday &h : list) {
+                // dedupe, since we support multiple holiday regions which may have similar holidays
+                QStringList &names = holidaysByDate[h.observedStartDate()];
+                if (!names.contains(h.name())) {
+                    names.append(h.name());
+                }
+            }
+        }
+    }
+    return holidaysByDate;
+}
+}
 
 class KOGlobalsSingletonPrivate
 {
@@ -46,29 +74,101 @@ QMap<QDate, QStringList> KOGlobals::holiday(const QDate &start, const QDate &end
 {
     QMap<QDate, QStringList> holidaysByDate;
 
-    if (mHolidayRegions.isEmpty()) {
+    if (mHolidayRegions.isEmpty() || !start.isValid() || !end.isValid()) {
         return holidaysByDate;
     }
 
-    setHolidayCategories(CalendarSupport::KCalPrefs::instance()->holidayCategories());
-    for (KHolidays::HolidayRegion *region : std::as_const(mHolidayRegions)) {
-        if (region && region->isValid()) {
-            region->setCategories(holidayCategories());
-            const KHolidays::Holiday::List list = region->rawHolidaysWithAstroSeasons(start, end);
-            const int listCount(list.count());
-            for (int i = 0; i < listCount; ++i) {
-                const KHolidays::Holiday &h = list.at(i);
-                // dedupe, since we support multiple holiday regions which may have similar holidays
-                if (!holidaysByDate[h.observedStartDate()].contains(h.name())) {
-                    holidaysByDate[h.observedStartDate()].append(h.name());
+    const QStringList categories = CalendarSupport::KCalPrefs::instance()->holidayCategories();
+    if (categories != mConfiguredHolidayCategories) {
+        mConfiguredHolidayCategories = categories;
+        setHolidayCategories(categories);
+    }
+
+    for (int year = start.year(); year <= end.year(); ++year) {
+        const QMap<QDate, QStringList> &yearHolidays = holidayYear(year);
+        for (auto it = yearHolidays.lowerBound(start); it != yearHolidays.cend() && it.key() <= end; ++it) {
+            QStringList &names = holidaysByDate[it.key()];
+            // dedupe, a holiday may be observed in the year after the one it belongs to
+            for (const QString &name : it.value()) {
+                if (!names.contains(name)) {
+                    names.append(name);
                 }
             }
         }
     }
 
+    prefetchHolidayYears(start.year(), end.year());
     return holidaysByDate;
 }
 
+const QMap<QDate, QStringList> &KOGlobals::holidayYear(int year)
+{
+    auto it = mHolidayYears.find(year);
+    if (it != mHolidayYears.end()) {
+        return it.value();
+    }
+
+    return mHolidayYears.insert(year, computeHolidayYear(mHolidayRegions, mHolidayCategories, year)).value();
+}
+
+void KOGlobals::prefetchHolidayYears(int firstYear, int lastYear)
+{
+    for (const int year : {firstYear - 1, lastYear + 1}) {
+        if (!mHolidayYears.contains(year) && !mPrefetchYears.contains(year)) {
+            mPrefetchYears.append(year);
+        }
+    }
+    startHolidayPrefetch();
+}
+
+void KOGlobals::startHolidayPrefetch()
+{
+    if (mPrefetchWatcher || mPrefetchYears.isEmpty() || mHolidayRegions.isEmpty() || !QCoreApplication::instance()) {
+        return;
+    }
+
+    QStringList regionCodes;
+    for (const KHolidays::HolidayRegion *region : std::as_const(mHolidayRegions)) {
+        regionCodes.append(region->regionCode());
+    }
+
+    mPrefetchWatcher = new QFutureWatcher<HolidayYears>(QCoreApplication::instance());
+    QObject::connect(mPrefetchWatcher, &QFutureWatcher<HolidayYears>::finished, mPrefetchWatcher, [this, generation = mHolidayGeneration]() {
+        QFutureWatcher<HolidayYears> *watcher = std::exchange(mPrefetchWatcher, nullptr);
+        if (generation == mHolidayGeneration) {
+            const HolidayYears years = watcher->result();
+            for (auto it = years.cbegin(), end = years.cend(); it != end; ++it) {
+                if (!mHolidayYears.contains(it.key())) {
+                    mHolidayYears.insert(it.key(), it.value());
+                }
+            }
+        }
+        watcher->deleteLater();
+        startHolidayPrefetch();
+    });
+    mPrefetchWatcher->setFuture(
+        QtConcurrent::run([regionCodes, categories = mHolidayCategories, years = std::exchange(mPrefetchYears, {})]() {
+            // The regions of the GUI thread are not shared with the worker
+            QList<KHolidays::HolidayRegion *> regions;
+            for (const QString &regionCode : regionCodes) {
+                regions.append(new KHolidays::HolidayRegion(regionCode));
+            }
+            HolidayYears result;
+            for (const int year : years) {
+                result.insert(year, computeHolidayYear(regions, categories, year));
+            }
+            qDeleteAll(regions);
+            return result;
+        }));
+}
+
+void KOGlobals::clearHolidayYears()
+{
+    mHolidayYears.clear();
+    mPrefetchYears.clear();
+    ++mHolidayGeneration;
+}
+
 /* cppcheck-suppress functionStatic */
 int KOGlobals::firstDayOfWeek() const
 {
@@ -85,6 +185,7 @@ void KOGlobals::setHolidays(const QStringList &regions)
 {
     qDeleteAll(mHolidayRegions);
     mHolidayRegions.clear();
+    clearHolidayYears();
     for (const QString &regionStr : regions) {
         auto region = new KHolidays::HolidayRegion(regionStr);
         if (region->isValid()) {
@@ -102,12 +203,16 @@ QList<KHolidays::HolidayRegion *> &KOGlobals::holidays()
 
 void KOGlobals::setHolidayCategories(const QStringList &categories)
 {
-    mHolidayCategories.clear();
+    QStringList validCategories;
     for (const QString &category : categories) {
         if (KHolidays::isHolidayCategoryValid(category)) {
-            mHolidayCategories.append(category);
+            validCategories.append(category);
         }
     }
+    if (validCategories != mHolidayCategories) {
+        mHolidayCategories = validCategories;
+        clearHolidayYears();
+    }
 }
 
 QStringList &KOGlobals::holidayCategories()
@@ -11,10 +11,14 @@
 #include "korganizerprivate_export.h"
 
 #include <QDate>
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QString>
 
+template<typename T>
+class QFutureWatcher;
+
 namespace KHolidays
 {
 class HolidayRegion;
@@ -31,6 +35,14 @@ public:
 
     ~KOGlobals();
 
+    /**
+       Returns the names of the holidays observed from @p start to @p end
+       in the configured regions and categories.
+
+       The holidays are computed for whole years and cached until the
+       regions or the categories change. The years next to the requested
+       ones are computed in advance on a worker thread.
+    */
     [[nodiscard]] QMap<QDate, QStringList> holiday(const QDate &start, const QDate &end);
 
     [[nodiscard]] int firstDayOfWeek() const;
@@ -63,6 +75,33 @@ protected:
     KOGlobals();
 
 private:
+    using HolidayYears = QHash<int, QMap<QDate, QStringList>>;
+
+    /** Returns the holidays of @p year, computing them if they are not cached. */
+    const QMap<QDate, QStringList> &holidayYear(int year);
+
+    /** Schedules the computation of the years around @p firstYear and @p lastYear. */
+    void prefetchHolidayYears(int firstYear, int lastYear);
+
+    /** Computes the scheduled years on a worker thread, unless that is running already. */
+    void startHolidayPrefetch();
+
+    /** Drops the cached years, e.g. because the regions changed. */
+    void clearHolidayYears();
+
     QList<KHolidays::HolidayRegion *> mHolidayRegions;
     QStringList mHolidayCategories;
+
+    /** the categories configured when mHolidayCategories was last set by holiday() */
+    QStringList mConfiguredHolidayCategories;
+
+    /** holidays by observed date for each computed year */
+    HolidayYears mHolidayYears;
+
+    /** increased whenever mHolidayYears is dropped, prefetched years of older generations are discarded */
+    quint64 mHolidayGeneration = 0;
+
+    /** years to compute in advance */
+    QList<int> mPrefetchYears;
+    QFutureWatcher<HolidayYears> *mPrefetchWatcher = nullptr;
 };
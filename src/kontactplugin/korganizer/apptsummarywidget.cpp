@@ -11,6 +11,8 @@
 #include "korganizerinterface.h"
 #include "korganizerplugin.h"
 #include "summaryeventinfo.h"
+#include "../summaryrefreshscheduler.h"
+#include "../summaryview.h"
 
 #include <CalendarSupport/CalendarSingleton>
 #include <CalendarSupport/Utils>
@@ -30,16 +32,17 @@
 #include <KLocalizedString>
 #include <KMessageBox>
 #include <KStandardGuiItem>
-#include <KUrlLabel>
 
-#include <QGridLayout>
-#include <QLabel>
 #include <QMenu>
 #include <QStyle>
 #include <QVBoxLayout>
 
 ApptSummaryWidget::ApptSummaryWidget(KOrganizerPlugin *plugin, QWidget *parent)
     : KontactInterface::Summary(parent)
+    , mCalendar(CalendarSupport::calendarSingleton())
+    , mEventIndex(mCalendar)
+    , mView(new SummaryView(this))
+    , mRefreshScheduler(new SummaryRefreshScheduler(this))
     , mPlugin(plugin)
 {
     auto mainLayout = new QVBoxLayout(this);
@@ -49,17 +52,15 @@ ApptSummaryWidget::ApptSummaryWidget(KOrganizerPlugin *plugin, QWidget *parent)
     QWidget *header = createHeader(this, QStringLiteral("view-calendar-upcoming-events"), i18nc("@title:group", "Upcoming Events"));
     mainLayout->addWidget(header);
 
-    mLayout = new QGridLayout();
-    mainLayout->addItem(mLayout);
-    mLayout->setSpacing(3);
-    mLayout->setRowStretch(6, 1);
-
-    mCalendar = CalendarSupport::calendarSingleton();
+    mainLayout->addWidget(mView);
+    connect(mView, &SummaryView::linkClicked, this, &ApptSummaryWidget::viewEvent);
+    connect(mView, &SummaryView::linkRightClicked, this, &ApptSummaryWidget::popupMenu);
 
     mChanger = new Akonadi::IncidenceChanger(parent);
 
-    connect(mCalendar.data(), &Akonadi::ETMCalendar::calendarChanged, this, &ApptSummaryWidget::updateView);
-    connect(mPlugin->core(), &KontactInterface::Core::minuteChanged, this, &ApptSummaryWidget::updateView);
+    connect(mRefreshScheduler, &SummaryRefreshScheduler::refreshRequested, this, &ApptSummaryWidget::updateView);
+    connect(mCalendar.data(), &Akonadi::ETMCalendar::calendarChanged, mRefreshScheduler, &SummaryRefreshScheduler::scheduleRefresh);
+    connect(mPlugin->core(), &KontactInterface::Core::minuteChanged, mRefreshScheduler, &SummaryRefreshScheduler::scheduleRefresh);
 
     // Update Configuration
     configUpdated();
@@ -83,9 +84,6 @@ void ApptSummaryWidget::configUpdated()
 
 void ApptSummaryWidget::updateView()
 {
-    qDeleteAll(mLabels);
-    mLabels.clear();
-
     // The event print consists of the following fields:
     //  icon:start date:days-to-go:summary:time range
     // where,
@@ -95,119 +93,71 @@ void ApptSummaryWidget::updateView()
     //   the summary is the event summary
     //   the time range is the start-end time (only for non-floating events)
 
-    int counter = 0;
-
     const QPixmap pm = QIcon::fromTheme(QStringLiteral("view-calendar-day")).pixmap(style()->pixelMetric(QStyle::PM_SmallIconSize));
     const QPixmap pmb = QIcon::fromTheme(QStringLiteral("view-calendar-birthday")).pixmap(style()->pixelMetric(QStyle::PM_SmallIconSize));
     const QPixmap pma = QIcon::fromTheme(QStringLiteral("view-calendar-wedding-anniversary")).pixmap(style()->pixelMetric(QStyle::PM_SmallIconSize));
 
-    QStringList uidList;
     SummaryEventInfo::setShowSpecialEvents(mShowBirthdaysFromCal, mShowAnniversariesFromCal);
     const QDate currentDate = QDate::currentDate();
 
-    const SummaryEventInfo::List events = SummaryEventInfo::eventsForRange(currentDate, currentDate.addDays(mDaysAhead - 1), mCalendar);
+    const SummaryEventInfo::List events = SummaryEventInfo::eventsForRange(currentDate, currentDate.addDays(mDaysAhead - 1), mCalendar, &mEventIndex);
 
-    QPalette todayPalette = palette();
-    KColorScheme::adjustBackground(todayPalette, KColorScheme::ActiveBackground, QPalette::Window);
-    QPalette urgentPalette = palette();
-    KColorScheme::adjustBackground(urgentPalette, KColorScheme::NegativeBackground, QPalette::Window);
+    const KColorScheme colorScheme(QPalette::Active, KColorScheme::Window);
+    const QBrush todayBrush = colorScheme.background(KColorScheme::ActiveBackground);
+    const QBrush urgentBrush = colorScheme.background(KColorScheme::NegativeBackground);
 
+    QList<SummaryRow> rows;
+    rows.reserve(events.size());
     for (const SummaryEventInfo *event : events) {
         const KCalendarCore::Event::Ptr ev = event->ev;
-        // print the first of the recurring event series only
-        if (ev->recurs()) {
-            if (uidList.contains(ev->instanceIdentifier())) {
-                continue;
-            }
-            uidList.append(ev->instanceIdentifier());
-        }
 
-        // Icon label
-        auto label = new QLabel(this);
+        SummaryRow row;
+
+        // Icon
+        SummaryCell icon;
         if (ev->categories().contains(QLatin1StringView("BIRTHDAY"), Qt::CaseInsensitive)) {
-            label->setPixmap(pmb);
+            icon.pixmap = pmb;
         } else if (ev->categories().contains(QLatin1StringView("ANNIVERSARY"), Qt::CaseInsensitive)) {
-            label->setPixmap(pma);
+            icon.pixmap = pma;
         } else {
-            label->setPixmap(pm);
-        }
-        label->setMaximumWidth(label->minimumSizeHint().width());
-        mLayout->addWidget(label, counter, 0);
-        mLabels.append(label);
-
-        // Start date or date span label
-        QString dateToDisplay = event->startDate;
-        if (!event->dateSpan.isEmpty()) {
-            dateToDisplay = event->dateSpan;
+            icon.pixmap = pm;
         }
-        label = new QLabel(dateToDisplay, this);
-        label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        mLayout->addWidget(label, counter, 1);
-        mLabels.append(label);
+        row.cells.append(icon);
+
+        // Start date or date span
+        SummaryCell date;
+        date.text = event->dateSpan.isEmpty() ? event->startDate : event->dateSpan;
         if (event->makeBold) {
-            QFont font = label->font();
-            font.setBold(true);
-            label->setFont(font);
-            if (!event->makeUrgent) {
-                label->setPalette(todayPalette);
-            } else {
-                label->setPalette(urgentPalette);
-            }
-            label->setAutoFillBackground(true);
+            date.bold = true;
+            date.background = event->makeUrgent ? urgentBrush : todayBrush;
         }
+        row.cells.append(date);
 
-        // Days to go label
-        label = new QLabel(event->daysToGo, this);
-        label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-        mLayout->addWidget(label, counter, 2);
-        mLabels.append(label);
-
-        // Summary label
-        auto urlLabel = new KUrlLabel(this);
-        urlLabel->setText(event->summaryText);
-        urlLabel->setUrl(event->summaryUrl);
-        urlLabel->setTextFormat(Qt::RichText);
-        urlLabel->setWordWrap(true);
-        mLayout->addWidget(urlLabel, counter, 3);
-        mLabels.append(urlLabel);
-        connect(urlLabel, &KUrlLabel::leftClickedUrl, this, [this, urlLabel] {
-            viewEvent(urlLabel->url());
-        });
-        connect(urlLabel, &KUrlLabel::rightClickedUrl, this, [this, urlLabel] {
-            popupMenu(urlLabel->url());
-        });
-        if (!event->summaryToolTip.isEmpty()) {
-            urlLabel->setToolTip(event->summaryToolTip);
-        }
-        if (!event->summaryStatusTip.isEmpty()) {
-            urlLabel->setStatusTip(event->summaryStatusTip);
-        }
+        // Days to go
+        row.cells.append({.text = event->daysToGo});
+
+        // Summary, its tips are built on the first hover
+        row.subjectColumn = row.cells.size();
+        row.cells.append({.text = event->summaryText, .richText = true});
+        row.url = event->summaryUrl;
+        row.completeTips = [calendar = mCalendar, ev, toolTipDate = event->toolTipDate](SummaryRow &row) {
+            row.toolTip = SummaryEventInfo::toolTip(calendar, ev, toolTipDate);
+            row.statusTip = SummaryEventInfo::statusTip(calendar, ev);
+        };
 
-        // Time range label (only for non-floating events)
+        // Time range (only for non-floating events)
         if (!event->timeRange.isEmpty()) {
-            label = new QLabel(event->timeRange, this);
-            label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            mLayout->addWidget(label, counter, 4);
-            mLabels.append(label);
+            row.cells.append({.text = event->timeRange, .richText = true});
         }
 
-        counter++;
+        rows.append(std::move(row));
     }
 
     qDeleteAll(events);
 
-    if (!counter) {
-        auto noEvents =
-            new QLabel(i18ncp("@label", "No upcoming events starting within the next day", "No upcoming events starting within the next %1 days", mDaysAhead),
-                       this);
-        noEvents->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
-        mLayout->addWidget(noEvents, 0, 0);
-        mLabels.append(noEvents);
-    }
-
-    for (QLabel *label : std::as_const(mLabels)) {
-        label->show();
-    }
+    mView->setPlaceholderText(
+        i18ncp("@label", "No upcoming events starting within the next day", "No upcoming events starting within the next %1 days", mDaysAhead));
+    mView->setRows(std::move(rows));
 }
 
 void ApptSummaryWidget::viewEvent(const QString &uid)
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "summaryeventindex.h"
+
 #include <Akonadi/ETMCalendar>
 #include <KontactInterface/Summary>
 
@@ -20,8 +22,8 @@ class Item;
 class IncidenceChanger;
 }
 
-class QGridLayout;
-class QLabel;
+class SummaryRefreshScheduler;
+class SummaryView;
 
 class ApptSummaryWidget : public KontactInterface::Summary
 {
@@ -51,10 +53,12 @@ private Q_SLOTS:
 
 private:
     Akonadi::ETMCalendar::Ptr mCalendar;
+    // Kept across the refreshes, which happen every minute
+    SummaryEventIndex mEventIndex;
     Akonadi::IncidenceChanger *mChanger = nullptr;
 
-    QGridLayout *mLayout = nullptr;
-    QList<QLabel *> mLabels;
+    SummaryView *const mView;
+    SummaryRefreshScheduler *const mRefreshScheduler;
     KOrganizerPlugin *mPlugin = nullptr;
     int mDaysAhead;
     bool mShowBirthdaysFromCal = false;
@@ -0,0 +1,112 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "summaryeventindex.h"
+
+#include <algorithm>
+
+namespace
+{
+// Events lasting longer than this are checked one by one, everything
+// else is found by a binary search on the start date
+constexpr qint64 maximumIndexedSpan = 31;
+}
+
+SummaryEventIndex::SummaryEventIndex(const Akonadi::ETMCalendar::Ptr &calendar)
+    : mCalendar(calendar)
+{
+    mCalendar->registerObserver(this);
+}
+
+SummaryEventIndex::~SummaryEventIndex()
+{
+    mCalendar->unregisterObserver(this);
+}
+
+KCalendarCore::Event::List SummaryEventIndex::events(QDate start, QDate end)
+{
+    ensureBuilt();
+
+    KCalendarCore::Event::List result;
+    const auto first = std::lower_bound(mEvents.cbegin(), mEvents.cend(), start.addDays(-maximumIndexedSpan), [](const Entry &entry, QDate date) {
+        return entry.start < date;
+    });
+    const auto last = std::upper_bound(first, mEvents.cend(), end, [](QDate date, const Entry &entry) {
+        return date < entry.start;
+    });
+    for (auto it = first; it != last; ++it) {
+        if (it->end >= start) {
+            result.append(it->event);
+        }
+    }
+    for (const Entry &entry : std::as_const(mLongEvents)) {
+        if (entry.start <= end && entry.end >= start) {
+            result.append(entry.event);
+        }
+    }
+    return result;
+}
+
+KCalendarCore::Event::List SummaryEventIndex::recurringEvents()
+{
+    ensureBuilt();
+    return mRecurringEvents;
+}
+
+void SummaryEventIndex::calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    invalidate(incidence);
+}
+
+void SummaryEventIndex::calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    invalidate(incidence);
+}
+
+void SummaryEventIndex::calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar)
+{
+    Q_UNUSED(calendar)
+    invalidate(incidence);
+}
+
+void SummaryEventIndex::invalidate(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    if (incidence && incidence->type() == KCalendarCore::Incidence::TypeEvent) {
+        mOccurrenceCache.invalidate(incidence);
+        mDirty = true;
+    }
+}
+
+void SummaryEventIndex::ensureBuilt()
+{
+    if (!mDirty) {
+        return;
+    }
+    mDirty = false;
+    mEvents.clear();
+    mLongEvents.clear();
+    mRecurringEvents.clear();
+
+    const KCalendarCore::Event::List events = mCalendar->events();
+    mEvents.reserve(events.size());
+    for (const KCalendarCore::Event::Ptr &event : events) {
+        if (event->recurs()) {
+            mRecurringEvents.append(event);
+            continue;
+        }
+        const Entry entry{event->dtStart().toLocalTime().date(), event->dtEnd().toLocalTime().date(), event};
+        if (entry.start.daysTo(entry.end) > maximumIndexedSpan) {
+            mLongEvents.append(entry);
+        } else {
+            mEvents.append(entry);
+        }
+    }
+    std::ranges::sort(mEvents, [](const Entry &lhs, const Entry &rhs) {
+        return lhs.start < rhs.start;
+    });
+}
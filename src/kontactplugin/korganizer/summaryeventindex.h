@@ -0,0 +1,80 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+#pragma once
+
+#include "../../occurrencecache.h"
+
+#include <Akonadi/ETMCalendar>
+
+#include <KCalendarCore/Event>
+
+#include <QDate>
+#include <QList>
+
+/**
+  Events of a calendar arranged for date range lookups.
+
+  Single events are sorted by their local start date, so the events of a
+  range are found with a binary search. Events spanning many days are kept
+  apart to keep that search tight. Recurring events are listed separately;
+  their occurrences are expanded through occurrenceCache().
+
+  The index observes the calendar and is rebuilt lazily on the first lookup
+  after an event was added, changed or removed.
+
+  @short Date range lookup of events for the appointment summary
+*/
+class SummaryEventIndex : public KCalendarCore::Calendar::CalendarObserver
+{
+public:
+    explicit SummaryEventIndex(const Akonadi::ETMCalendar::Ptr &calendar);
+    ~SummaryEventIndex() override;
+
+    /**
+      Returns the single events overlapping [@p start, @p end], in local time.
+    */
+    [[nodiscard]] KCalendarCore::Event::List events(QDate start, QDate end);
+
+    /**
+      Returns all recurring events of the calendar.
+    */
+    [[nodiscard]] KCalendarCore::Event::List recurringEvents();
+
+    [[nodiscard]] OccurrenceCache *occurrenceCache()
+    {
+        return &mOccurrenceCache;
+    }
+
+protected:
+    /**
+     *  Reimplemented from KCalendarCore::Calendar::CalendarObserver
+     */
+    void calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar) override;
+
+private:
+    struct Entry {
+        QDate start;
+        QDate end;
+        KCalendarCore::Event::Ptr event;
+    };
+
+    void invalidate(const KCalendarCore::Incidence::Ptr &incidence);
+    void ensureBuilt();
+
+    const Akonadi::ETMCalendar::Ptr mCalendar;
+    OccurrenceCache mOccurrenceCache;
+
+    /** single events spanning a few days, sorted by start date */
+    QList<Entry> mEvents;
+    /** single events spanning more days than mEvents may */
+    QList<Entry> mLongEvents;
+    KCalendarCore::Event::List mRecurringEvents;
+    bool mDirty = true;
+};
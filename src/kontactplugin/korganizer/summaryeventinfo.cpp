@@ -9,6 +9,7 @@
 */
 
 #include "summaryeventinfo.h"
+#include "summaryeventindex.h"
 
 #include <Akonadi/Item>
 
@@ -23,26 +24,35 @@ using namespace KCalUtils;
 
 #include <QDate>
 #include <QLocale>
+#include <QSet>
 #include <QStringList>
 
+#include <optional>
+
 bool SummaryEventInfo::mShowBirthdays = true;
 bool SummaryEventInfo::mShowAnniversaries = true;
 
-using DateTimeByUidHash = QHash<QString, QDateTime>;
-Q_GLOBAL_STATIC(DateTimeByUidHash, sDateTimeByUid)
+namespace
+{
+struct EventOccurrence {
+    KCalendarCore::Event::Ptr event;
+    // Start of the occurrence shown, clipped to the start of the range
+    QDateTime start;
+    // Occurrence after the shown one, for recurring events
+    QDateTime following;
+};
 
-static bool eventLessThan(const KCalendarCore::Event::Ptr &event1, const KCalendarCore::Event::Ptr &event2)
+bool occurrenceLessThan(const EventOccurrence &occurrence1, const EventOccurrence &occurrence2)
 {
-    const QDateTime kdt1 = sDateTimeByUid()->value(event1->instanceIdentifier());
-    const QDateTime kdt2 = sDateTimeByUid()->value(event2->instanceIdentifier());
-    if (kdt1 < kdt2) {
+    if (occurrence1.start < occurrence2.start) {
         return true;
-    } else if (kdt1 > kdt2) {
+    } else if (occurrence1.start > occurrence2.start) {
         return false;
     } else {
-        return event1->summary() < event2->summary();
+        return occurrence1.event->summary() < occurrence2.event->summary();
     }
 }
+}
 
 void SummaryEventInfo::setShowSpecialEvents(bool showBirthdays, bool showAnniversaries)
 {
@@ -68,54 +78,87 @@ bool SummaryEventInfo::skip(const KCalendarCore::Event::Ptr &event)
 SummaryEventInfo::SummaryEventInfo() = default;
 
 /**static*/
-SummaryEventInfo::List SummaryEventInfo::eventsForRange(QDate start, QDate end, const Akonadi::ETMCalendar::Ptr &calendar)
+QString SummaryEventInfo::toolTip(const Akonadi::ETMCalendar::Ptr &calendar, const KCalendarCore::Event::Ptr &event, QDate date)
+{
+    QString displayName;
+    const Akonadi::Item item = calendar->item(event);
+    if (item.isValid()) {
+        const Akonadi::Collection col = item.parentCollection();
+        if (col.isValid()) {
+            displayName = col.displayName();
+        }
+    }
+    return KCalUtils::IncidenceFormatter::toolTipStr(displayName, event, date, true);
+}
+
+/**static*/
+QString SummaryEventInfo::statusTip(const Akonadi::ETMCalendar::Ptr &calendar, const KCalendarCore::Event::Ptr &event)
 {
-    const KCalendarCore::Event::List allEvents = calendar->events();
-    KCalendarCore::Event::List events;
+    const Akonadi::Item item = calendar->item(event);
+    if (item.isValid() && calendar->hasRight(item, Akonadi::Collection::CanDeleteItem)) {
+        return i18nc("@info:status", "Edit Event: \"%1\"", event->summary());
+    }
+    return i18nc("@info:status", "Show Event: \"%1\"", event->summary());
+}
+
+/**static*/
+SummaryEventInfo::List SummaryEventInfo::eventsForRange(QDate start, QDate end, const Akonadi::ETMCalendar::Ptr &calendar, SummaryEventIndex *index)
+{
+    std::optional<SummaryEventIndex> localIndex;
+    if (!index) {
+        localIndex.emplace(calendar);
+        index = &*localIndex;
+    }
+
     const auto currentDateTime = QDateTime::currentDateTime();
     const QDate currentDate = currentDateTime.date();
 
-    sDateTimeByUid()->clear();
-    for (int i = 0; i < allEvents.count(); ++i) {
-        const KCalendarCore::Event::Ptr &event = allEvents.at(i);
+    QList<EventOccurrence> occurrences;
+    const KCalendarCore::Event::List singleEvents = index->events(start, end);
+    for (const KCalendarCore::Event::Ptr &event : singleEvents) {
         if (skip(event)) {
             continue;
         }
-
         const auto eventStart = event->dtStart().toLocalTime();
-        const auto eventEnd = event->dtEnd().toLocalTime();
-        if (event->recurs()) {
-            const auto occurrences = event->recurrence()->timesInInterval(QDateTime(start, {}), QDateTime(end, {}));
-            if (!occurrences.isEmpty()) {
-                events << event;
-                sDateTimeByUid()->insert(event->instanceIdentifier(), occurrences.first());
-            }
-        } else {
-            if ((end >= eventStart.date() && start <= eventEnd.date()) || (start >= eventStart.date() && end <= eventEnd.date())) {
-                events << event;
-                if (eventStart.date() < start) {
-                    sDateTimeByUid()->insert(event->instanceIdentifier(), QDateTime(start.startOfDay()));
-                } else {
-                    sDateTimeByUid()->insert(event->instanceIdentifier(), eventStart);
-                }
-            }
+        occurrences.append({event, eventStart.date() < start ? start.startOfDay() : eventStart, {}});
+    }
+
+    // Each recurrence is expanded once; the labels below reuse the result.
+    // Only the first occurrence of a series is listed, even if the series
+    // is found in several calendars.
+    const QDateTime intervalStart(start, {});
+    const QDateTime intervalEnd(end, {});
+    const KCalendarCore::Event::List recurringEvents = index->recurringEvents();
+    QSet<QString> listedSeries;
+    listedSeries.reserve(recurringEvents.size());
+    for (const KCalendarCore::Event::Ptr &event : recurringEvents) {
+        if (skip(event)) {
+            continue;
+        }
+        const QString series = event->instanceIdentifier();
+        if (listedSeries.contains(series)) {
+            continue;
+        }
+        const auto times = index->occurrenceCache()->timesInInterval(event, intervalStart, intervalEnd);
+        if (!times.isEmpty()) {
+            listedSeries.insert(series);
+            const QDateTime following = times.size() > 1 ? times.at(1) : event->recurrence()->getNextDateTime(times.first());
+            occurrences.append({event, times.first(), following});
         }
     }
 
-    std::ranges::sort(events, eventLessThan);
+    std::ranges::sort(occurrences, occurrenceLessThan);
 
     SummaryEventInfo::List eventInfoList;
-    KCalendarCore::Event::Ptr ev;
-    eventInfoList.reserve(events.count());
-    auto itEnd = events.constEnd();
-    for (auto it = events.constBegin(); it != itEnd; ++it) {
-        ev = *it;
+    eventInfoList.reserve(occurrences.count());
+    for (const EventOccurrence &occurrence : std::as_const(occurrences)) {
+        const KCalendarCore::Event::Ptr &ev = occurrence.event;
         // Count number of days remaining in multiday event
         int span = 1;
         int dayof = 1;
         const auto eventStart = ev->dtStart().toLocalTime();
         const auto eventEnd = ev->dtEnd().toLocalTime();
-        const QDate occurrenceStartDate = sDateTimeByUid()->value(ev->instanceIdentifier()).date();
+        const QDate occurrenceStartDate = occurrence.start.date();
 
         QDate startOfMultiday = eventStart.date();
         if (startOfMultiday < currentDate) {
@@ -192,10 +235,7 @@ SummaryEventInfo::List SummaryEventInfo::eventsForRange(QDate start, QDate end,
                 if (!ev->recurs()) {
                     secs = currentDateTime.secsTo(ev->dtStart());
                 } else {
-                    QDateTime kdt(start, QTime(0, 0, 0), QTimeZone::LocalTime);
-                    kdt = kdt.addSecs(-1);
-                    const auto next = ev->recurrence()->getNextDateTime(kdt);
-                    secs = currentDateTime.secsTo(next);
+                    secs = currentDateTime.secsTo(occurrence.start);
                 }
                 if (secs > 0) {
                     str = i18nc("@label eg. in 1 hour 2 minutes", "in ");
@@ -220,10 +260,7 @@ SummaryEventInfo::List SummaryEventInfo::eventsForRange(QDate start, QDate end,
                     if (!ev->recurs()) {
                         secsToEnd = currentDateTime.secsTo(ev->dtEnd());
                     } else {
-                        QDateTime kdt(start, QTime(0, 0, 0), QTimeZone::LocalTime);
-                        kdt = kdt.addSecs(-1);
-                        const QDateTime next = ev->recurrence()->getNextDateTime(kdt).addSecs(durationAsSeconds);
-                        secsToEnd = currentDateTime.secsTo(next);
+                        secsToEnd = currentDateTime.secsTo(occurrence.start.addSecs(durationAsSeconds));
                     }
                     if (secsToEnd > 0) {
                         str = i18nc("@label the event is currently in-progress", "in-progress");
@@ -262,22 +299,7 @@ SummaryEventInfo::List SummaryEventInfo::eventsForRange(QDate start, QDate end,
         }
         summaryEvent->summaryUrl = ev->uid();
 
-        QString displayName;
-        Akonadi::Item item = calendar->item(ev);
-        bool writeable = false;
-        if (item.isValid()) {
-            const Akonadi::Collection col = item.parentCollection();
-            if (col.isValid()) {
-                displayName = col.displayName();
-            }
-            writeable = calendar->hasRight(item, Akonadi::Collection::CanDeleteItem);
-        }
-        summaryEvent->summaryToolTip = KCalUtils::IncidenceFormatter::toolTipStr(displayName, ev, start, true);
-        if (writeable) {
-            summaryEvent->summaryStatusTip = i18nc("@info:status", "Edit Event: \"%1\"", ev->summary());
-        } else {
-            summaryEvent->summaryStatusTip = i18nc("@info:status", "Show Event: \"%1\"", ev->summary());
-        }
+        summaryEvent->toolTipDate = start;
         // Time range label (only for non-floating events)
         str.clear();
         if (!ev->allDay()) {
@@ -300,10 +322,7 @@ SummaryEventInfo::List SummaryEventInfo::eventsForRange(QDate start, QDate end,
 
         // For recurring events, append the next occurrence to the time range label
         if (ev->recurs()) {
-            QDateTime kdt(start, QTime(0, 0, 0));
-            kdt = kdt.addSecs(-1);
-            const QDateTime next = ev->recurrence()->getNextDateTime(kdt);
-            const QString tmp = IncidenceFormatter::dateTimeToString(ev->recurrence()->getNextDateTime(next), ev->allDay(), true);
+            const QString tmp = IncidenceFormatter::dateTimeToString(occurrence.following, ev->allDay(), true);
             if (!summaryEvent->timeRange.isEmpty()) {
                 summaryEvent->timeRange += QLatin1StringView("<br>");
             }
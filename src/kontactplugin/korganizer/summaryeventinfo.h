@@ -11,7 +11,9 @@
 
 #include <Akonadi/ETMCalendar>
 
-class QDate;
+#include <QDate>
+
+class SummaryEventIndex;
 
 class SummaryEventInfo
 {
@@ -20,11 +22,31 @@ public:
 
     SummaryEventInfo();
 
+    /**
+      Returns the events of @p calendar between @p start and @p end, inclusive.
+      The events are looked up in @p index, which must belong to @p calendar.
+      Without an index a temporary one is built. A recurring series is
+      returned once, for its first occurrence in the range.
+    */
     static List eventsForRange(QDate start,
                                QDate end, // range is inclusive
-                               const Akonadi::ETMCalendar::Ptr &calendar);
+                               const Akonadi::ETMCalendar::Ptr &calendar,
+                               SummaryEventIndex *index = nullptr);
     static void setShowSpecialEvents(bool showBirthdays, bool showAnniversaries);
 
+    /**
+      Returns the tool tip for @p event as shown by the summary of @p date.
+      Building it is expensive, so it is only done for the rows the user
+      points at.
+    */
+    static QString toolTip(const Akonadi::ETMCalendar::Ptr &calendar, const KCalendarCore::Event::Ptr &event, QDate date);
+
+    /**
+      Returns the status tip for @p event, telling whether clicking it edits
+      or shows it.
+    */
+    static QString statusTip(const Akonadi::ETMCalendar::Ptr &calendar, const KCalendarCore::Event::Ptr &event);
+
     KCalendarCore::Event::Ptr ev;
     QString startDate;
     QString dateSpan;
@@ -32,8 +54,8 @@ public:
     QString timeRange;
     QString summaryText;
     QString summaryUrl;
-    QString summaryToolTip;
-    QString summaryStatusTip;
+    // The date the tool tip is built for, see toolTip()
+    QDate toolTipDate;
     bool makeBold = false;
     bool makeUrgent = false;
 
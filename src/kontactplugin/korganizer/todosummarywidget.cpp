@@ -10,6 +10,8 @@
 #include "todosummarywidget.h"
 #include "korganizerinterface.h"
 #include "todoplugin.h"
+#include "../summaryrefreshscheduler.h"
+#include "../summaryview.h"
 #include <CalendarSupport/CalendarSingleton>
 
 #include <Akonadi/CalendarUtils>
@@ -27,18 +29,60 @@
 #include <KLocalizedString>
 #include <KMessageBox>
 #include <KStandardGuiItem>
-#include <KUrlLabel>
 
-#include <QGridLayout>
-#include <QLabel>
+#include <QHash>
 #include <QMenu>
 #include <QStyle>
 #include <QTextDocument> // for Qt::mightBeRichText
 #include <QVBoxLayout>
 
+#include <algorithm>
+
+namespace
+{
+QDateTime localDue(const KCalendarCore::Todo::Ptr &todo)
+{
+    // All-day due dates are floating and must not be shifted
+    return todo->allDay() ? todo->dtDue() : todo->dtDue().toLocalTime();
+}
+
+// Ranks to-dos by local due date, all-day before timed, due time, priority
+// and summary: to-dos without due date last, undefined priority last
+bool todoLessThan(const KCalendarCore::Todo::Ptr &todo1, const KCalendarCore::Todo::Ptr &todo2)
+{
+    if (todo1->hasDueDate() != todo2->hasDueDate()) {
+        return todo1->hasDueDate();
+    }
+    if (todo1->hasDueDate()) {
+        const QDateTime due1 = localDue(todo1);
+        const QDateTime due2 = localDue(todo2);
+        if (due1.date() != due2.date()) {
+            return due1.date() < due2.date();
+        }
+        if (todo1->allDay() != todo2->allDay()) {
+            return todo1->allDay();
+        }
+        if (!todo1->allDay() && due1.time() != due2.time()) {
+            return due1.time() < due2.time();
+        }
+    }
+
+    // 1 is the highest priority, 0 means undefined
+    const int priority1 = todo1->priority() == 0 ? 10 : todo1->priority();
+    const int priority2 = todo2->priority() == 0 ? 10 : todo2->priority();
+    if (priority1 != priority2) {
+        return priority1 < priority2;
+    }
+
+    return todo1->summary() < todo2->summary();
+}
+}
+
 TodoSummaryWidget::TodoSummaryWidget(TodoPlugin *plugin, QWidget *parent)
     : KontactInterface::Summary(parent)
     , mPlugin(plugin)
+    , mView(new SummaryView(this))
+    , mRefreshScheduler(new SummaryRefreshScheduler(this))
 {
     auto mainLayout = new QVBoxLayout(this);
     mainLayout->setSpacing(3);
@@ -47,16 +91,16 @@ TodoSummaryWidget::TodoSummaryWidget(TodoPlugin *plugin, QWidget *parent)
     QWidget *header = createHeader(this, QStringLiteral("view-calendar-tasks"), i18nc("@title:group", "Pending To-dos"));
     mainLayout->addWidget(header);
 
-    mLayout = new QGridLayout();
-    mainLayout->addItem(mLayout);
-    mLayout->setSpacing(3);
-    mLayout->setRowStretch(6, 1);
+    mainLayout->addWidget(mView);
+    connect(mView, &SummaryView::linkClicked, this, &TodoSummaryWidget::viewTodo);
+    connect(mView, &SummaryView::linkRightClicked, this, &TodoSummaryWidget::popupMenu);
     mCalendar = CalendarSupport::calendarSingleton();
 
     mChanger = new Akonadi::IncidenceChanger(parent);
 
-    connect(mCalendar.data(), &Akonadi::ETMCalendar::calendarChanged, this, &TodoSummaryWidget::updateView);
-    connect(mPlugin->core(), &KontactInterface::Core::dayChanged, this, &TodoSummaryWidget::updateView);
+    connect(mRefreshScheduler, &SummaryRefreshScheduler::refreshRequested, this, &TodoSummaryWidget::updateView);
+    connect(mCalendar.data(), &Akonadi::ETMCalendar::calendarChanged, mRefreshScheduler, &SummaryRefreshScheduler::scheduleRefresh);
+    connect(mPlugin->core(), &KontactInterface::Core::dayChanged, mRefreshScheduler, &SummaryRefreshScheduler::scheduleRefresh);
 
     updateView();
 }
@@ -66,9 +110,6 @@ TodoSummaryWidget::~TodoSummaryWidget() = default;
 void TodoSummaryWidget::updateView()
 {
     // Note: match default entry values with those in KCMTodoSummary::load().
-    qDeleteAll(mLabels);
-    mLabels.clear();
-
     KConfig config(QStringLiteral("kcmtodosummaryrc"));
     KConfigGroup group = config.group(QStringLiteral("Days"));
     int const mDaysToGo = group.readEntry("DaysToShow", 7);
@@ -83,9 +124,7 @@ void TodoSummaryWidget::updateView()
     // for each todo,
     //   if it passes the filter, append to a list
     //   else continue
-    // sort todolist by summary
-    // sort todolist by priority
-    // sort todolist by due-date
+    // sort todolist by due-date, then priority, then summary
     // print todolist
 
     // the filter is created by the configuration summary options, but includes
@@ -93,11 +132,19 @@ void TodoSummaryWidget::updateView()
     //    which types of to-dos to hide
 
     KCalendarCore::Todo::List prList;
+    // Summaries of the to-dos by uid, to show the parent of a to-do
+    QHash<QString, QString> summaries;
 
     const QDate currDate = QDate::currentDate();
     const QTime currTime = QTime::currentTime();
     const KCalendarCore::Todo::List todos = mCalendar->todos();
+    summaries.reserve(todos.size());
     for (const KCalendarCore::Todo::Ptr &todo : todos) {
+        // Exceptions share the uid of their series
+        if (!todo->hasRecurrenceId()) {
+            summaries.insert(todo->uid(), todo->summary());
+        }
+
         if (todo->hasDueDate()) {
             const int daysTo = currDate.daysTo(todo->dtDue().date());
             if (daysTo >= mDaysToGo) {
@@ -123,16 +170,7 @@ void TodoSummaryWidget::updateView()
 
         prList.append(todo);
     }
-    if (!prList.isEmpty()) {
-        KCalendarCore::Todo::List todoListSorted1(prList);
-        KCalendarCore::Todo::List todoListSorted2(prList);
-        KCalendarCore::Todo::List todoListSorted3(prList);
-        prList = Akonadi::ETMCalendar::sortTodos(std::move(todoListSorted1), KCalendarCore::TodoSortSummary, KCalendarCore::SortDirectionAscending);
-        /* cppcheck-suppress redundantAssignment */
-        prList = Akonadi::ETMCalendar::sortTodos(std::move(todoListSorted2), KCalendarCore::TodoSortPriority, KCalendarCore::SortDirectionAscending);
-        /* cppcheck-suppress redundantAssignment */
-        prList = Akonadi::ETMCalendar::sortTodos(std::move(todoListSorted3), KCalendarCore::TodoSortDueDate, KCalendarCore::SortDirectionAscending);
-    }
+    std::ranges::stable_sort(prList, todoLessThan);
 
     // The to-do print consists of the following fields:
     //  icon:due date:days-to-go:priority:summary:status
@@ -150,14 +188,15 @@ void TodoSummaryWidget::updateView()
     //     open-ended
     //     not-started (no start date and 0% completed)
 
-    int counter = 0;
+    QList<SummaryRow> rows;
     if (!prList.isEmpty()) {
         QPixmap const pm = QIcon::fromTheme(QStringLiteral("view-calendar-tasks")).pixmap(style()->pixelMetric(QStyle::PM_SmallIconSize));
 
-        QPalette todayPalette = palette();
-        KColorScheme::adjustBackground(todayPalette, KColorScheme::ActiveBackground, QPalette::Window);
-        QPalette urgentPalette = palette();
-        KColorScheme::adjustBackground(urgentPalette, KColorScheme::NegativeBackground, QPalette::Window);
+        const KColorScheme colorScheme(QPalette::Active, KColorScheme::Window);
+        const QBrush todayBrush = colorScheme.background(KColorScheme::ActiveBackground);
+        const QBrush urgentBrush = colorScheme.background(KColorScheme::NegativeBackground);
+
+        rows.reserve(prList.size());
 
         QString str;
 
@@ -165,14 +204,7 @@ void TodoSummaryWidget::updateView()
             bool makeBold = false;
             int daysTo = -1;
 
-            // Icon label
-            auto label = new QLabel(this);
-            label->setPixmap(pm);
-            label->setMaximumWidth(label->minimumSizeHint().width());
-            mLayout->addWidget(label, counter, 0);
-            mLabels.append(label);
-
-            // Due date label
+            // Due date
             bool makeUrgent = false;
             str.clear();
             if (todo->hasDueDate() && todo->dtDue().date().isValid()) {
@@ -220,24 +252,9 @@ void TodoSummaryWidget::updateView()
                     makeUrgent = true;
                 }
             }
+            const QString dueDateStr = str;
 
-            label = new QLabel(str, this);
-            label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            mLayout->addWidget(label, counter, 1);
-            mLabels.append(label);
-            if (makeBold || makeUrgent) {
-                QFont font = label->font();
-                font.setBold(true);
-                label->setFont(font);
-                if (makeUrgent) {
-                    label->setPalette(urgentPalette);
-                } else {
-                    label->setPalette(todayPalette);
-                }
-                label->setAutoFillBackground(true);
-            }
-
-            // Days togo/ago label
+            // Days togo/ago
             str.clear();
             if (todo->hasDueDate() && todo->dtDue().date().isValid()) {
                 if (daysTo > 0) {
@@ -260,83 +277,77 @@ void TodoSummaryWidget::updateView()
                     }
                 }
             }
-            label = new QLabel(str, this);
-            label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            mLayout->addWidget(label, counter, 2);
-            mLabels.append(label);
-
-            // Priority label
-            str = QLatin1Char('[') + QString::number(todo->priority()) + u']';
-            label = new QLabel(str, this);
-            label->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-            label->setMaximumWidth(3.5 * QFontMetrics(label->font()).averageCharWidth());
-            mLayout->addWidget(label, counter, 3);
-            mLabels.append(label);
-
-            // Summary label
+            const QString daysToStr = str;
+
+            // Priority
+            const QString priorityStr = QLatin1Char('[') + QString::number(todo->priority()) + u']';
+
+            // Summary
             str = todo->summary();
             if (!todo->relatedTo().isEmpty()) { // show parent only, not entire ancestry
-                KCalendarCore::Incidence::Ptr const inc = mCalendar->incidence(todo->relatedTo());
-                if (inc) {
+                const auto parent = summaries.constFind(todo->relatedTo());
+                if (parent != summaries.cend()) {
+                    str = *parent + u':' + str;
+                } else if (const KCalendarCore::Incidence::Ptr inc = mCalendar->incidence(todo->relatedTo())) {
+                    // The parent is not a to-do, or is hidden by the calendar filter
                     str = inc->summary() + u':' + str;
                 }
             }
             if (!Qt::mightBeRichText(str)) {
                 str = str.toHtmlEscaped();
             }
+            const QString summaryStr = str;
 
-            QString displayName;
-            Akonadi::Item item = mCalendar->item(todo);
-            bool writeable = false;
-            if (item.isValid()) {
-                const Akonadi::Collection col = item.parentCollection();
-                if (col.isValid()) {
-                    displayName = col.displayName();
-                }
-                writeable = mCalendar->hasRight(item, Akonadi::Collection::CanDeleteItem);
+            SummaryRow row;
+            row.cells.append({.pixmap = pm});
+
+            SummaryCell dueDate{.text = dueDateStr};
+            if (makeBold || makeUrgent) {
+                dueDate.bold = true;
+                dueDate.background = makeUrgent ? urgentBrush : todayBrush;
             }
+            row.cells.append(dueDate);
+
+            row.cells.append({.text = daysToStr});
+            row.cells.append({.text = priorityStr, .alignment = Qt::AlignRight | Qt::AlignVCenter});
+
+            // Summary, its tips are built on the first hover
+            row.subjectColumn = row.cells.size();
+            row.cells.append({.text = summaryStr, .richText = true});
+            row.url = todo->uid();
+            row.completeTips = [calendar = mCalendar, todo, currDate](SummaryRow &row) {
+                QString displayName;
+                const Akonadi::Item item = calendar->item(todo);
+                bool writeable = false;
+                if (item.isValid()) {
+                    const Akonadi::Collection col = item.parentCollection();
+                    if (col.isValid()) {
+                        displayName = col.displayName();
+                    }
+                    writeable = calendar->hasRight(item, Akonadi::Collection::CanDeleteItem);
+                }
+                row.toolTip = KCalUtils::IncidenceFormatter::toolTipStr(displayName, todo, currDate, true);
+                if (writeable) {
+                    row.statusTip = i18nc("@info:status", "Edit To-do: \"%1\"", todo->summary());
+                } else {
+                    row.statusTip = i18nc("@info:status", "Show To-do: \"%1\"", todo->summary());
+                }
+            };
 
-            auto urlLabel = new KUrlLabel(this);
-            urlLabel->setText(str);
-            urlLabel->setUrl(todo->uid());
-            urlLabel->setTextFormat(Qt::RichText);
-            urlLabel->setWordWrap(true);
-            urlLabel->setToolTip(KCalUtils::IncidenceFormatter::toolTipStr(displayName, todo, currDate, true));
-            if (writeable) {
-                urlLabel->setStatusTip(i18nc("@info:status", "Edit To-do: \"%1\"", todo->summary()));
-            } else {
-                urlLabel->setStatusTip(i18nc("@info:status", "Show To-do: \"%1\"", todo->summary()));
+            // State
+            SummaryCell stateCell{.text = stateStr(todo)};
+            if (todo->isOverdue()) {
+                stateCell.foreground = QBrush(Qt::red);
             }
-            mLayout->addWidget(urlLabel, counter, 4);
-            mLabels.append(urlLabel);
-            connect(urlLabel, &KUrlLabel::leftClickedUrl, this, [this, urlLabel] {
-                viewTodo(urlLabel->url());
-            });
-            connect(urlLabel, &KUrlLabel::rightClickedUrl, this, [this, urlLabel] {
-                popupMenu(urlLabel->url());
-            });
-            // State text label
-            str = stateStr(todo);
-            label = new QLabel(str, this);
-            label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            mLayout->addWidget(label, counter, 5);
-            mLabels.append(label);
-
-            counter++;
+            row.cells.append(std::move(stateCell));
+
+            rows.append(std::move(row));
         }
-    } // foreach
-
-    if (counter == 0) {
-        auto noTodos =
-            new QLabel(i18ncp("@label", "No pending to-dos due within the next day", "No pending to-dos due within the next %1 days", mDaysToGo), this);
-        noTodos->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
-        mLayout->addWidget(noTodos, 0, 0);
-        mLabels.append(noTodos);
     }
 
-    for (QLabel *label : std::as_const(mLabels)) {
-        label->show();
-    }
+    mView->setPlaceholderText(
+        i18ncp("@label", "No pending to-dos due within the next day", "No pending to-dos due within the next %1 days", mDaysToGo));
+    mView->setRows(std::move(rows));
 }
 
 void TodoSummaryWidget::viewTodo(const QString &uid)
@@ -433,7 +444,7 @@ QString TodoSummaryWidget::stateStr(const KCalendarCore::Todo::Ptr &todo) const
     if (todo->isOpenEnded()) {
         str1 = i18nc("@label", "open-ended");
     } else if (todo->isOverdue()) {
-        str1 = QLatin1StringView("<font color=\"red\">") + i18nc("@label the to-do is overdue", "overdue") + QLatin1StringView("</font>");
+        str1 = i18nc("@label the to-do is overdue", "overdue");
     } else if (startsToday(todo)) {
         str1 = i18nc("@label the to-do starts today", "starts today");
     }
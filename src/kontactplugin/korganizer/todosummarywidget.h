@@ -23,8 +23,8 @@ namespace Akonadi
 class IncidenceChanger;
 }
 
-class QGridLayout;
-class QLabel;
+class SummaryRefreshScheduler;
+class SummaryView;
 
 class TodoSummaryWidget : public KontactInterface::Summary
 {
@@ -55,7 +55,8 @@ private Q_SLOTS:
 
 private:
     TodoPlugin *mPlugin = nullptr;
-    QGridLayout *mLayout = nullptr;
+    SummaryView *const mView;
+    SummaryRefreshScheduler *const mRefreshScheduler;
 
     bool mHideInProgress = false;
     bool mHideOverdue = false;
@@ -63,7 +64,6 @@ private:
     bool mHideOpenEnded = false;
     bool mHideNotStarted = false;
 
-    QList<QLabel *> mLabels;
     Akonadi::ETMCalendar::Ptr mCalendar;
     Akonadi::IncidenceChanger *mChanger = nullptr;
 
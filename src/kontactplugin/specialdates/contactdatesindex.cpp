@@ -0,0 +1,394 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "contactdatesindex.h"
+#include "korganizer_kontactplugins_specialdates_debug.h"
+
+#include <Akonadi/CollectionFetchJob>
+#include <Akonadi/CollectionFetchScope>
+#include <Akonadi/ItemFetchJob>
+#include <Akonadi/ItemFetchScope>
+#include <Akonadi/Monitor>
+
+#include <KContacts/Addressee>
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+
+#include <utility>
+
+namespace
+{
+constexpr quint32 indexMagic = 0x4B534449; // "KSDI"
+constexpr quint32 indexVersion = 1;
+
+// Delay before modifications are written to disk
+constexpr int saveDelay = 10 * 1000;
+
+int dayKey(QDate date)
+{
+    return date.month() * 100 + date.day();
+}
+
+QImage scaledPhoto(const KContacts::Addressee &addressee)
+{
+    const KContacts::Picture pic = addressee.photo();
+    if (!pic.isIntern() || pic.data().isNull()) {
+        return {};
+    }
+    const QImage img = pic.data();
+    if (img.width() > img.height()) {
+        return img.scaledToWidth(32);
+    }
+    return img.scaledToHeight(32);
+}
+}
+
+ContactDatesIndex::ContactDatesIndex(QObject *parent)
+    : QObject(parent)
+    , mMonitor(new Akonadi::Monitor(this))
+    , mFileName(defaultFileName())
+{
+    mSaveTimer.setSingleShot(true);
+    mSaveTimer.setInterval(saveDelay);
+    connect(&mSaveTimer, &QTimer::timeout, this, &ContactDatesIndex::save);
+
+    // Collects the notifications of a burst of changes into one fetch
+    mFetchTimer.setSingleShot(true);
+    connect(&mFetchTimer, &QTimer::timeout, this, &ContactDatesIndex::fetchPayloads);
+
+    load();
+
+    // The notifications only carry ids and revisions; the payload, photo
+    // included, is fetched for the contacts whose revision changed
+    mMonitor->setMimeTypeMonitored(KContacts::Addressee::mimeType());
+    connect(mMonitor, &Akonadi::Monitor::itemAdded, this, [this](const Akonadi::Item &item, const Akonadi::Collection &collection) {
+        queuePayloadFetch(item, collection.id());
+    });
+    connect(mMonitor, &Akonadi::Monitor::itemChanged, this, [this](const Akonadi::Item &item) {
+        queuePayloadFetch(item, item.parentCollection().id());
+    });
+    connect(mMonitor, &Akonadi::Monitor::itemRemoved, this, [this](const Akonadi::Item &item) {
+        mPendingFetches.remove(item.id());
+        if (removeItem(item.id())) {
+            scheduleSave();
+            Q_EMIT changed();
+        }
+    });
+    connect(mMonitor, &Akonadi::Monitor::itemMoved, this, [this](const Akonadi::Item &item, const Akonadi::Collection &, const Akonadi::Collection &destination) {
+        const auto it = mContacts.find(item.id());
+        if (it != mContacts.end()) {
+            it->collectionId = destination.id();
+            scheduleSave();
+        }
+        const auto pending = mPendingFetches.find(item.id());
+        if (pending != mPendingFetches.end()) {
+            *pending = destination.id();
+        }
+    });
+    connect(mMonitor, &Akonadi::Monitor::collectionRemoved, this, &ContactDatesIndex::removeCollection);
+
+    auto job = new Akonadi::CollectionFetchJob(Akonadi::Collection::root(), Akonadi::CollectionFetchJob::Recursive, this);
+    job->fetchScope().setContentMimeTypes({KContacts::Addressee::mimeType()});
+    connect(job, &KJob::result, this, &ContactDatesIndex::slotCollectionsFetched);
+}
+
+ContactDatesIndex::~ContactDatesIndex()
+{
+    if (mDirty) {
+        save();
+    }
+}
+
+QString ContactDatesIndex::defaultFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QLatin1StringView("/korganizer/contactdatesindex");
+}
+
+QList<ContactDatesIndex::Contact> ContactDatesIndex::birthdays(QDate first, QDate last) const
+{
+    return lookup(mBirthdays, first, last);
+}
+
+QList<ContactDatesIndex::Contact> ContactDatesIndex::anniversaries(QDate first, QDate last) const
+{
+    return lookup(mAnniversaries, first, last);
+}
+
+void ContactDatesIndex::slotCollectionsFetched(KJob *job)
+{
+    if (job->error()) {
+        qCWarning(KORGANIZER_KONTACTPLUGINS_SPECIALDATES_LOG) << job->errorString();
+        return;
+    }
+    const Akonadi::Collection::List collections = qobject_cast<Akonadi::CollectionFetchJob *>(job)->collections();
+    for (const Akonadi::Collection &collection : collections) {
+        if (!collection.contentMimeTypes().contains(KContacts::Addressee::mimeType())) {
+            continue;
+        }
+        // Only ids and revisions, to find out what changed while Kontact was not running
+        auto fetchJob = new Akonadi::ItemFetchJob(collection, this);
+        fetchJob->setProperty("collectionId", collection.id());
+        connect(fetchJob, &KJob::result, this, &ContactDatesIndex::slotRevisionsFetched);
+    }
+}
+
+void ContactDatesIndex::slotRevisionsFetched(KJob *job)
+{
+    if (job->error()) {
+        qCWarning(KORGANIZER_KONTACTPLUGINS_SPECIALDATES_LOG) << job->errorString();
+        return;
+    }
+    const Akonadi::Collection::Id collectionId = job->property("collectionId").toLongLong();
+    const Akonadi::Item::List items = qobject_cast<Akonadi::ItemFetchJob *>(job)->items();
+
+    QSet<Akonadi::Item::Id> presentIds;
+    presentIds.reserve(items.size());
+    for (const Akonadi::Item &item : items) {
+        presentIds.insert(item.id());
+        queuePayloadFetch(item, collectionId);
+    }
+
+    // Contacts deleted while Kontact was not running
+    QList<Akonadi::Item::Id> missingIds;
+    for (const Contact &contact : std::as_const(mContacts)) {
+        if (contact.collectionId == collectionId && !presentIds.contains(contact.id)) {
+            missingIds.append(contact.id);
+        }
+    }
+    for (const Akonadi::Item::Id id : std::as_const(missingIds)) {
+        (void)removeItem(id);
+    }
+    if (!missingIds.isEmpty()) {
+        scheduleSave();
+        Q_EMIT changed();
+    }
+}
+
+void ContactDatesIndex::queuePayloadFetch(const Akonadi::Item &item, Akonadi::Collection::Id collectionId)
+{
+    const auto it = mContacts.constFind(item.id());
+    if (it != mContacts.cend() && it->revision == item.revision()) {
+        return;
+    }
+    mPendingFetches.insert(item.id(), collectionId);
+    if (!mFetchTimer.isActive()) {
+        mFetchTimer.start();
+    }
+}
+
+void ContactDatesIndex::fetchPayloads()
+{
+    if (mPendingFetches.isEmpty()) {
+        return;
+    }
+
+    const QHash<Akonadi::Item::Id, Akonadi::Collection::Id> collectionIds = std::exchange(mPendingFetches, {});
+    Akonadi::Item::List items;
+    items.reserve(collectionIds.size());
+    for (auto it = collectionIds.cbegin(), end = collectionIds.cend(); it != end; ++it) {
+        items.append(Akonadi::Item(it.key()));
+    }
+
+    auto job = new Akonadi::ItemFetchJob(items, this);
+    job->fetchScope().fetchFullPayload();
+    connect(job, &Akonadi::ItemFetchJob::itemsReceived, this, [this, collectionIds](const Akonadi::Item::List &items) {
+        for (const Akonadi::Item &item : items) {
+            const Akonadi::Collection::Id collectionId = item.parentCollection().isValid() ? item.parentCollection().id() : collectionIds.value(item.id(), -1);
+            updateItem(item, collectionId);
+        }
+        scheduleSave();
+        Q_EMIT changed();
+    });
+    connect(job, &KJob::result, this, [](KJob *job) {
+        if (job->error()) {
+            qCWarning(KORGANIZER_KONTACTPLUGINS_SPECIALDATES_LOG) << job->errorString();
+        }
+    });
+}
+
+void ContactDatesIndex::updateItem(const Akonadi::Item &item, Akonadi::Collection::Id collectionId)
+{
+    (void)removeItem(item.id());
+    if (!item.hasPayload<KContacts::Addressee>()) {
+        return;
+    }
+
+    const auto addressee = item.payload<KContacts::Addressee>();
+    Contact contact;
+    contact.id = item.id();
+    contact.collectionId = collectionId;
+    contact.revision = item.revision();
+    contact.birthday = addressee.birthday().date();
+    // Stored the way KAddressBook and the birthdays resource do
+    contact.anniversary = QDate::fromString(addressee.custom(QStringLiteral("KADDRESSBOOK"), QStringLiteral("X-Anniversary")), Qt::ISODate);
+    // Contacts without dates are only kept to remember their revision
+    if (contact.birthday.isValid() || contact.anniversary.isValid()) {
+        contact.name = addressee.realName();
+        contact.photo = scaledPhoto(addressee);
+    }
+    addContact(contact);
+}
+
+void ContactDatesIndex::addContact(const Contact &contact)
+{
+    if (contact.birthday.isValid()) {
+        mBirthdays.insert(dayKey(contact.birthday), contact.id);
+    }
+    if (contact.anniversary.isValid()) {
+        mAnniversaries.insert(dayKey(contact.anniversary), contact.id);
+    }
+    mContacts.insert(contact.id, contact);
+}
+
+bool ContactDatesIndex::removeItem(Akonadi::Item::Id id)
+{
+    const auto it = mContacts.constFind(id);
+    if (it == mContacts.cend()) {
+        return false;
+    }
+    if (it->birthday.isValid()) {
+        mBirthdays.remove(dayKey(it->birthday), id);
+    }
+    if (it->anniversary.isValid()) {
+        mAnniversaries.remove(dayKey(it->anniversary), id);
+    }
+    mContacts.erase(it);
+    return true;
+}
+
+void ContactDatesIndex::removeCollection(const Akonadi::Collection &collection)
+{
+    // Items of a removed collection are not reported one by one
+    QList<Akonadi::Item::Id> ids;
+    for (const Contact &contact : std::as_const(mContacts)) {
+        if (contact.collectionId == collection.id()) {
+            ids.append(contact.id);
+        }
+    }
+    for (const Akonadi::Item::Id id : std::as_const(ids)) {
+        (void)removeItem(id);
+    }
+    if (!ids.isEmpty()) {
+        scheduleSave();
+        Q_EMIT changed();
+    }
+}
+
+bool ContactDatesIndex::save()
+{
+    mSaveTimer.stop();
+
+    QDir().mkpath(QFileInfo(mFileName).absolutePath());
+    QSaveFile file(mFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KORGANIZER_KONTACTPLUGINS_SPECIALDATES_LOG) << "Unable to write contact dates index" << mFileName << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << indexMagic << indexVersion << qint64(mContacts.size());
+    for (const Contact &contact : std::as_const(mContacts)) {
+        stream << qint64(contact.id) << qint64(contact.collectionId) << qint32(contact.revision) << contact.name << contact.birthday << contact.anniversary
+               << contact.photo;
+    }
+
+    if (!file.commit()) {
+        qCWarning(KORGANIZER_KONTACTPLUGINS_SPECIALDATES_LOG) << "Unable to write contact dates index" << mFileName << file.errorString();
+        return false;
+    }
+    mDirty = false;
+    return true;
+}
+
+void ContactDatesIndex::load()
+{
+    QFile file(mFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != indexMagic || version != indexVersion) {
+        qCDebug(KORGANIZER_KONTACTPLUGINS_SPECIALDATES_LOG) << "Ignoring contact dates index with unknown format" << mFileName;
+        return;
+    }
+
+    qint64 contactCount = 0;
+    stream >> contactCount;
+    for (qint64 i = 0; i < contactCount && stream.status() == QDataStream::Ok; ++i) {
+        qint64 id = 0;
+        qint64 collectionId = -1;
+        qint32 revision = -1;
+        Contact contact;
+        stream >> id >> collectionId >> revision >> contact.name >> contact.birthday >> contact.anniversary >> contact.photo;
+        contact.id = id;
+        contact.collectionId = collectionId;
+        contact.revision = revision;
+        addContact(contact);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(KORGANIZER_KONTACTPLUGINS_SPECIALDATES_LOG) << "Contact dates index is corrupted, rebuilding it" << mFileName;
+        mContacts.clear();
+        mBirthdays.clear();
+        mAnniversaries.clear();
+    }
+}
+
+void ContactDatesIndex::scheduleSave()
+{
+    mDirty = true;
+    if (!mSaveTimer.isActive()) {
+        mSaveTimer.start();
+    }
+}
+
+QList<ContactDatesIndex::Contact> ContactDatesIndex::lookup(const QMultiMap<int, Akonadi::Item::Id> &days, QDate first, QDate last) const
+{
+    QList<Contact> result;
+    if (!first.isValid() || !last.isValid() || last < first) {
+        return result;
+    }
+
+    const auto append = [this, &days, &result](int from, int to) {
+        const auto end = days.upperBound(to);
+        for (auto it = days.lowerBound(from); it != end; ++it) {
+            result.append(mContacts.value(it.value()));
+        }
+    };
+
+    // February 29 is celebrated on the 28th in other years
+    int lastKey = dayKey(last);
+    if (lastKey == 228 && !QDate::isLeapYear(last.year())) {
+        lastKey = 229;
+    }
+    constexpr int firstKeyOfYear = 101;
+    constexpr int lastKeyOfYear = 1231;
+    if (first.daysTo(last) >= 365) {
+        append(firstKeyOfYear, lastKeyOfYear);
+    } else if (first.year() == last.year()) {
+        append(dayKey(first), lastKey);
+    } else {
+        append(dayKey(first), lastKeyOfYear);
+        append(firstKeyOfYear, lastKey);
+    }
+    return result;
+}
+
+#include "moc_contactdatesindex.cpp"
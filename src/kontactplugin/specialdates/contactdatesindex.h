@@ -0,0 +1,109 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+#pragma once
+
+#include <Akonadi/Collection>
+#include <Akonadi/Item>
+
+#include <QDate>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QMultiMap>
+#include <QObject>
+#include <QTimer>
+
+class KJob;
+
+namespace Akonadi
+{
+class Monitor;
+}
+
+/**
+  Birthdays and anniversaries of all contacts, looked up by day of the year.
+
+  Only what the special dates summary shows is kept, so a summary refresh
+  never has to fetch contacts. The index is stored on disk together with
+  the item revisions; on startup only the payloads of contacts which were
+  added or changed since are fetched. Afterwards the index follows the
+  changes reported by Akonadi.
+
+  @short Persistent index of contact birthdays and anniversaries
+*/
+class ContactDatesIndex : public QObject
+{
+    Q_OBJECT
+public:
+    struct Contact {
+        Akonadi::Item::Id id = -1;
+        Akonadi::Collection::Id collectionId = -1;
+        int revision = -1;
+        QString name;
+        QDate birthday;
+        QDate anniversary;
+        /** the contact's photo scaled down to icon size, if it has one */
+        QImage photo;
+    };
+
+    explicit ContactDatesIndex(QObject *parent = nullptr);
+    ~ContactDatesIndex() override;
+
+    /**
+      Returns the location of the index of the current user.
+    */
+    [[nodiscard]] static QString defaultFileName();
+
+    /**
+      Returns the contacts whose birthday falls between @p first and @p last,
+      whichever year they were born in.
+    */
+    [[nodiscard]] QList<Contact> birthdays(QDate first, QDate last) const;
+
+    /**
+      Returns the contacts whose anniversary falls between @p first and @p last.
+    */
+    [[nodiscard]] QList<Contact> anniversaries(QDate first, QDate last) const;
+
+    /**
+      Writes the index to disk. Returns true on success.
+    */
+    bool save();
+
+Q_SIGNALS:
+    /**
+      Emitted when contacts were loaded, added, changed or removed.
+    */
+    void changed();
+
+private:
+    void load();
+    void scheduleSave();
+    void slotCollectionsFetched(KJob *job);
+    void slotRevisionsFetched(KJob *job);
+    void queuePayloadFetch(const Akonadi::Item &item, Akonadi::Collection::Id collectionId);
+    void fetchPayloads();
+    void updateItem(const Akonadi::Item &item, Akonadi::Collection::Id collectionId);
+    void addContact(const Contact &contact);
+    [[nodiscard]] bool removeItem(Akonadi::Item::Id id);
+    void removeCollection(const Akonadi::Collection &collection);
+    [[nodiscard]] QList<Contact> lookup(const QMultiMap<int, Akonadi::Item::Id> &days, QDate first, QDate last) const;
+
+    Akonadi::Monitor *const mMonitor;
+    const QString mFileName;
+    bool mDirty = false;
+    QTimer mSaveTimer;
+    QTimer mFetchTimer;
+    /** collections of the items whose payload has to be fetched */
+    QHash<Akonadi::Item::Id, Akonadi::Collection::Id> mPendingFetches;
+    /** all contacts, including those without dates, so their revision is known */
+    QHash<Akonadi::Item::Id, Contact> mContacts;
+    /** item ids keyed by month * 100 + day of the date */
+    QMultiMap<int, Akonadi::Item::Id> mBirthdays;
+    QMultiMap<int, Akonadi::Item::Id> mAnniversaries;
+};
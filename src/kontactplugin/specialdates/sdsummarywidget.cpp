@@ -9,63 +9,49 @@
 
 #include "sdsummarywidget.h"
 #include "korganizer_kontactplugins_specialdates_debug.h"
+#include "../summaryrefreshscheduler.h"
+#include "../summaryview.h"
+#include "contactdatesindex.h"
 #include <KontactInterface/Core>
 #include <KontactInterface/Plugin>
 
-#include <Akonadi/ContactSearchJob>
 #include <Akonadi/ContactViewerDialog>
 #include <Akonadi/EntityDisplayAttribute>
 #include <Akonadi/ItemFetchJob>
 #include <Akonadi/ItemFetchScope>
-#include <Akonadi/SearchQuery>
 
 #include <CalendarSupport/CalendarSingleton>
 #include <CalendarSupport/KCalPrefs>
 #include <CalendarSupport/Utils>
 
 #include <KCalendarCore/Calendar>
+#include <KCalendarCore/Recurrence>
 
 #include <KColorScheme>
+#include <KContacts/Addressee>
 #include <KConfig>
 #include <KConfigGroup>
 #include <KHolidays/HolidayRegion>
 #include <KLocalizedString>
-#include <KUrlLabel>
 
 #include <QDBusConnection>
 #include <QDBusMessage>
 #include <QDate>
 #include <QEvent>
-#include <QGridLayout>
-#include <QLabel>
+#include <QIcon>
+#include <QImage>
 #include <QMenu>
 #include <QPointer>
 #include <QStyle>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <optional>
 
 using namespace KHolidays;
 
 namespace
 {
-class BirthdaySearchJob : public Akonadi::ItemSearchJob
-{
-    Q_OBJECT
-public:
-    explicit BirthdaySearchJob(QObject *parent, int daysInAdvance);
-};
-
-BirthdaySearchJob::BirthdaySearchJob(QObject *parent, int daysInAdvance)
-    : ItemSearchJob(parent)
-{
-    fetchScope().fetchFullPayload();
-    setMimeTypes({KContacts::Addressee::mimeType()});
-
-    Akonadi::SearchQuery query;
-    query.addTerm(QStringLiteral("birthday"), QDate::currentDate().toJulianDay(), Akonadi::SearchTerm::CondGreaterOrEqual);
-    query.addTerm(QStringLiteral("birthday"), QDate::currentDate().addDays(daysInAdvance).toJulianDay(), Akonadi::SearchTerm::CondLessOrEqual);
-
-    ItemSearchJob::setQuery(query);
-}
-
 enum SDIncidenceType {
     IncidenceTypeContact,
     IncidenceTypeEvent
@@ -91,13 +77,16 @@ public:
     QString summary;
     QString desc;
     int span = 0; // #days in the special occasion.
-    KContacts::Addressee addressee;
+    QString name;
+    QImage photo;
     Akonadi::Item item;
 };
 
 SDSummaryWidget::SDSummaryWidget(KontactInterface::Plugin *plugin, QWidget *parent)
     : KontactInterface::Summary(parent)
     , mCalendar(CalendarSupport::calendarSingleton())
+    , mView(new SummaryView(this))
+    , mRefreshScheduler(new SummaryRefreshScheduler(this))
     , mPlugin(plugin)
 {
     // Create the Summary Layout
@@ -108,10 +97,9 @@ SDSummaryWidget::SDSummaryWidget(KontactInterface::Plugin *plugin, QWidget *pare
     QWidget *header = createHeader(this, QStringLiteral("view-calendar-special-occasion"), i18nc("@title:group", "Upcoming Special Dates"));
     mainLayout->addWidget(header);
 
-    mLayout = new QGridLayout();
-    mainLayout->addItem(mLayout);
-    mLayout->setSpacing(3);
-    mLayout->setRowStretch(6, 1);
+    mainLayout->addWidget(mView);
+    connect(mView, &SummaryView::linkClicked, this, &SDSummaryWidget::mailContact);
+    connect(mView, &SummaryView::linkRightClicked, this, &SDSummaryWidget::popupMenu);
 
     // Default settings
     mDaysAhead = 7;
@@ -120,13 +108,13 @@ SDSummaryWidget::SDSummaryWidget(KontactInterface::Plugin *plugin, QWidget *pare
     mShowAnniversariesFromKAB = true;
     mShowAnniversariesFromCal = true;
     mShowHolidays = true;
-    mJobRunning = false;
     mShowSpecialsFromCal = true;
 
     // Setup the Addressbook
-    connect(mPlugin->core(), &KontactInterface::Core::dayChanged, this, &SDSummaryWidget::updateView);
+    connect(mRefreshScheduler, &SummaryRefreshScheduler::refreshRequested, this, &SDSummaryWidget::updateView);
+    connect(mPlugin->core(), &KontactInterface::Core::dayChanged, mRefreshScheduler, &SummaryRefreshScheduler::scheduleRefresh);
 
-    connect(mCalendar.data(), &Akonadi::ETMCalendar::calendarChanged, this, &SDSummaryWidget::updateView);
+    connect(mCalendar.data(), &Akonadi::ETMCalendar::calendarChanged, mRefreshScheduler, &SummaryRefreshScheduler::scheduleRefresh);
 
     // Update Configuration
     configUpdated();
@@ -155,6 +143,16 @@ void SDSummaryWidget::configUpdated()
 
     mShowSpecialsFromCal = group.readEntry("SpecialsFromCalendar", true);
 
+    if (mShowBirthdaysFromKAB || mShowAnniversariesFromKAB) {
+        if (!mContactDates) {
+            mContactDates = new ContactDatesIndex(this);
+            connect(mContactDates, &ContactDatesIndex::changed, mRefreshScheduler, &SummaryRefreshScheduler::scheduleRefresh);
+        }
+    } else {
+        delete mContactDates;
+        mContactDates = nullptr;
+    }
+
     updateView();
 }
 
@@ -205,38 +203,40 @@ int SDSummaryWidget::dayof(const KCalendarCore::Event::Ptr &event, const QDate &
     return dayof;
 }
 
-void SDSummaryWidget::slotBirthdayJobFinished(KJob *job)
+void SDSummaryWidget::appendContactDates()
 {
-    // ;)
-    auto bJob = qobject_cast<BirthdaySearchJob *>(job);
-    if (bJob) {
-        const auto items = bJob->items();
-        for (const Akonadi::Item &item : items) {
-            if (item.hasPayload<KContacts::Addressee>()) {
-                const auto addressee = item.payload<KContacts::Addressee>();
-                const QDate birthday = addressee.birthday().date();
-                if (birthday.isValid()) {
-                    SDEntry entry;
-                    entry.type = IncidenceTypeContact;
-                    entry.category = CategoryBirthday;
-                    dateDiff(birthday, entry.daysTo, entry.yearsOld);
-                    if (entry.daysTo < mDaysAhead) {
-                        // We need to check the days ahead here because we don't
-                        // filter out Contact Birthdays by mDaysAhead in createLabels().
-                        entry.date = birthday;
-                        entry.addressee = addressee;
-                        entry.item = item;
-                        entry.span = 1;
-                        mDates.append(entry);
-                    }
-                }
-            }
+    const QDate firstDay = QDate::currentDate();
+    const QDate lastDay = firstDay.addDays(mDaysAhead - 1);
+    const auto append = [this](const ContactDatesIndex::Contact &contact, SDCategory category, QDate date) {
+        SDEntry entry;
+        entry.type = IncidenceTypeContact;
+        entry.category = category;
+        dateDiff(date, entry.daysTo, entry.yearsOld);
+        if (entry.daysTo < mDaysAhead) {
+            // We need to check the days ahead here because we don't
+            // filter out Contact Birthdays by mDaysAhead in createLabels().
+            entry.date = date;
+            entry.name = contact.name;
+            entry.photo = contact.photo;
+            entry.item = Akonadi::Item(contact.id);
+            entry.item.setMimeType(KContacts::Addressee::mimeType());
+            entry.span = 1;
+            mDates.append(entry);
         }
-        // Carry on.
-        createLabels();
-    }
+    };
 
-    mJobRunning = false;
+    if (mShowBirthdaysFromKAB) {
+        const QList<ContactDatesIndex::Contact> contacts = mContactDates->birthdays(firstDay, lastDay);
+        for (const ContactDatesIndex::Contact &contact : contacts) {
+            append(contact, CategoryBirthday, contact.birthday);
+        }
+    }
+    if (mShowAnniversariesFromKAB) {
+        const QList<ContactDatesIndex::Contact> contacts = mContactDates->anniversaries(firstDay, lastDay);
+        for (const ContactDatesIndex::Contact &contact : contacts) {
+            append(contact, CategoryAnniversary, contact.anniversary);
+        }
+    }
 }
 
 static bool eventLessThan(const SDEntry &event1, const SDEntry &event2)
@@ -244,139 +244,143 @@ static bool eventLessThan(const SDEntry &event1, const SDEntry &event2)
     return event1.daysTo < event2.daysTo;
 }
 
-void SDSummaryWidget::createLabels()
+// The days between first and last on which event takes place
+static QList<QDate> occurrenceDays(const KCalendarCore::Event::Ptr &event, QDate first, QDate last, const QTimeZone &timeZone)
 {
-    // Remove all special date labels from the layout and delete them, as we
-    // will re-create all labels below.
-    setUpdatesEnabled(false);
-    for (QLabel *label : std::as_const(mLabels)) {
-        mLayout->removeWidget(label);
-        delete label;
-        update();
+    const auto localDate = [&event, &timeZone](const QDateTime &dt) {
+        return event->allDay() ? dt.date() : dt.toTimeZone(timeZone).date();
+    };
+    const QDate startDate = localDate(event->dtStart());
+    QDate endDate = localDate(event->dtEnd());
+    if (!event->allDay() && endDate > startDate && event->dtEnd().toTimeZone(timeZone).time() == QTime(0, 0)) {
+        // Ends at midnight, so the last day is not touched
+        endDate = endDate.addDays(-1);
+    }
+    const qint64 length = std::max<qint64>(0, startDate.daysTo(endDate));
+
+    QList<QDate> occurrenceStarts;
+    if (event->recurs()) {
+        const QList<QDateTime> times = event->recurrence()->timesInInterval(QDateTime(first.addDays(-length), QTime(0, 0), timeZone),
+                                                                            QDateTime(last, QTime(23, 59, 59), timeZone));
+        occurrenceStarts.reserve(times.size());
+        for (const QDateTime &time : times) {
+            occurrenceStarts.append(localDate(time));
+        }
+    } else {
+        occurrenceStarts.append(startDate);
     }
-    mLabels.clear();
-
-    QDate dt;
-    for (dt = QDate::currentDate(); dt <= QDate::currentDate().addDays(mDaysAhead - 1); dt = dt.addDays(1)) {
-        const KCalendarCore::Event::List events =
-            mCalendar->events(dt, mCalendar->timeZone(), KCalendarCore::EventSortStartDate, KCalendarCore::SortDirectionAscending);
-
-        for (const KCalendarCore::Event::Ptr &ev : events) {
-            if (ev->customProperty("KABC", "BIRTHDAY") == QLatin1StringView("YES")) {
-                // Skipping, because these are got by the BirthdaySearchJob
-                // See comments in updateView()
-                continue;
-            }
-
-            if (!mShowAnniversariesFromKAB && ev->customProperty("KABC", "ANNIVERSARY") == QLatin1StringView("YES")) {
-                continue;
-            }
 
-            if (!ev->categoriesStr().isEmpty()) {
-                QStringList::ConstIterator it2;
-                const QStringList c = ev->categories();
-                QStringList::ConstIterator const end(c.constEnd());
-                for (it2 = c.constBegin(); it2 != end; ++it2) {
-                    const QString itUpper((*it2).toUpper());
-                    // Append Birthday Event?
-                    if (mShowBirthdaysFromCal && (itUpper == QLatin1StringView("BIRTHDAY"))) {
-                        SDEntry entry;
-                        entry.type = IncidenceTypeEvent;
-                        entry.category = CategoryBirthday;
-                        entry.date = dt;
-                        entry.summary = ev->summary();
-                        entry.desc = ev->description();
-                        dateDiff(ev->dtStart().date(), entry.daysTo, entry.yearsOld);
-                        entry.span = 1;
-
-                        /* The following check is to prevent duplicate entries,
-                         * so in case of having a KCal incidence with category birthday
-                         * with summary and date equal to some KABC Attendee we don't show it
-                         * FIXME: port to akonadi, it's kresource based
-                         * */
-                        if (/*!check( bdayRes, dt, ev->summary() )*/ true) {
-                            mDates.append(entry);
-                        }
-                        break;
-                    }
+    QList<QDate> days;
+    for (const QDate &occurrenceStart : std::as_const(occurrenceStarts)) {
+        const QDate occurrenceEnd = std::min(occurrenceStart.addDays(length), last);
+        for (QDate day = std::max(occurrenceStart, first); day <= occurrenceEnd; day = day.addDays(1)) {
+            days.append(day);
+        }
+    }
+    // Overlapping occurrences only count once per day
+    std::ranges::sort(days);
+    days.erase(std::unique(days.begin(), days.end()), days.end());
+    return days;
+}
 
-                    // Append Anniversary Event?
-                    if (itUpper == QLatin1StringView("ANNIVERSARY")) {
-                        // !mShowAnniversariesFromKAB was handled above.
-                        const bool isKAB = ev->customProperty("KABC", "ANNIVERSARY") == QLatin1StringView("YES");
-                        if (isKAB || mShowAnniversariesFromCal) {
-                            SDEntry entry;
-                            entry.type = IncidenceTypeEvent;
-                            entry.category = CategoryAnniversary;
-                            entry.date = dt;
-                            entry.summary = ev->summary();
-                            entry.desc = ev->description();
-                            dateDiff(ev->dtStart().date(), entry.daysTo, entry.yearsOld);
-                            entry.span = 1;
-                            mDates.append(entry);
-                        }
-                        break;
-                    }
+void SDSummaryWidget::createLabels()
+{
+    const QDate firstDay = QDate::currentDate();
+    const QDate lastDay = firstDay.addDays(mDaysAhead - 1);
+    const QTimeZone timeZone = mCalendar->timeZone();
+
+    // Matched once per event; the first category with an enabled kind of
+    // special date decides
+    const auto eventCategory = [this](const KCalendarCore::Event::Ptr &event) -> std::optional<SDCategory> {
+        const QStringList categories = event->categories();
+        for (const QString &category : categories) {
+            if (mShowBirthdaysFromCal && category.compare(QLatin1StringView("BIRTHDAY"), Qt::CaseInsensitive) == 0) {
+                return CategoryBirthday;
+            }
+            if (category.compare(QLatin1StringView("ANNIVERSARY"), Qt::CaseInsensitive) == 0) {
+                if (mShowAnniversariesFromCal) {
+                    return CategoryAnniversary;
+                }
+                return std::nullopt;
+            }
+            if (mShowHolidays && category.compare(QLatin1StringView("HOLIDAY"), Qt::CaseInsensitive) == 0) {
+                return CategoryHoliday;
+            }
+            if (mShowSpecialsFromCal && category.compare(QLatin1StringView("SPECIAL OCCASION"), Qt::CaseInsensitive) == 0) {
+                return CategoryOther;
+            }
+        }
+        return std::nullopt;
+    };
+
+    // One query for the whole range; each event is then placed on the days it occurs on
+    const KCalendarCore::Event::List events = mCalendar->events(firstDay, lastDay, timeZone);
+    for (const KCalendarCore::Event::Ptr &ev : events) {
+        if (ev->customProperty("KABC", "BIRTHDAY") == QLatin1StringView("YES")
+            || ev->customProperty("KABC", "ANNIVERSARY") == QLatin1StringView("YES")) {
+            // Skipping, because these are got from the contacts directly
+            // See comments in updateView()
+            continue;
+        }
 
-                    // Append Holiday Event?
-                    if (mShowHolidays && (itUpper == QLatin1StringView("HOLIDAY"))) {
-                        SDEntry entry;
-                        entry.type = IncidenceTypeEvent;
-                        entry.category = CategoryHoliday;
-                        entry.date = dt;
-                        entry.summary = ev->summary();
-                        entry.desc = ev->description();
-                        dateDiff(dt, entry.daysTo, entry.yearsOld);
-                        entry.yearsOld = -1; // ignore age of holidays
-                        entry.span = span(ev);
-                        if (entry.span > 1 && dayof(ev, dt) > 1) { // skip days 2,3,...
-                            break;
-                        }
-                        mDates.append(entry);
-                        break;
-                    }
+        const std::optional<SDCategory> category = eventCategory(ev);
+        if (!category) {
+            continue;
+        }
 
-                    // Append Special Occasion Event?
-                    if (mShowSpecialsFromCal && (itUpper == QLatin1StringView("SPECIAL OCCASION"))) {
-                        SDEntry entry;
-                        entry.type = IncidenceTypeEvent;
-                        entry.category = CategoryOther;
-                        entry.date = dt;
-                        entry.summary = ev->summary();
-                        entry.desc = ev->description();
-                        dateDiff(dt, entry.daysTo, entry.yearsOld);
-                        entry.yearsOld = -1; // ignore age of special occasions
-                        entry.span = span(ev);
-                        if (entry.span > 1 && dayof(ev, dt) > 1) { // skip days 2,3,...
-                            break;
-                        }
-                        mDates.append(entry);
-                        break;
-                    }
+        const QList<QDate> days = occurrenceDays(ev, firstDay, lastDay, timeZone);
+        for (const QDate &dt : days) {
+            SDEntry entry;
+            entry.type = IncidenceTypeEvent;
+            entry.category = *category;
+            entry.date = dt;
+            entry.summary = ev->summary();
+            entry.desc = ev->description();
+            switch (*category) {
+            case CategoryBirthday:
+            case CategoryAnniversary:
+                /* FIXME: a KCal incidence with category birthday with summary and
+                 * date equal to some KABC Attendee should not be shown twice.
+                 * Port to akonadi, it's kresource based
+                 * */
+                dateDiff(ev->dtStart().date(), entry.daysTo, entry.yearsOld);
+                entry.span = 1;
+                break;
+            default:
+                dateDiff(dt, entry.daysTo, entry.yearsOld);
+                entry.yearsOld = -1; // ignore age of holidays and special occasions
+                entry.span = span(ev);
+                if (entry.span > 1 && dayof(ev, dt) > 1) { // skip days 2,3,...
+                    continue;
                 }
+                break;
             }
+            mDates.append(entry);
         }
     }
 
     // Search for Holidays
     if (mShowHolidays) {
         if (initHolidays()) {
-            for (dt = QDate::currentDate(); dt <= QDate::currentDate().addDays(mDaysAhead - 1); dt = dt.addDays(1)) {
-                mHolidays->setCategories(CalendarSupport::KCalPrefs::instance()->holidayCategories());
-                QList<Holiday> const holidays = mHolidays->rawHolidaysWithAstroSeasons(dt);
-                QList<Holiday>::ConstIterator it = holidays.constBegin();
-                for (; it != holidays.constEnd(); ++it) {
+            mHolidays->setCategories(CalendarSupport::KCalPrefs::instance()->holidayCategories());
+            const QList<Holiday> holidays = mHolidays->rawHolidaysWithAstroSeasons(firstDay, lastDay);
+            for (const Holiday &holiday : holidays) {
+                SDCategory category = CategoryOther;
+                const QStringList categories = holiday.categoryList();
+                if (categories.contains(QLatin1StringView("seasonal"))) {
+                    category = CategorySeasonal;
+                } else if (categories.contains(QLatin1StringView("public"))) {
+                    category = CategoryHoliday;
+                }
+
+                // Listed on every day it lasts, as a per day lookup would
+                const QDate holidayEnd = std::min(holiday.observedEndDate(), lastDay);
+                for (QDate dt = std::max(holiday.observedStartDate(), firstDay); dt <= holidayEnd; dt = dt.addDays(1)) {
                     SDEntry entry;
                     entry.type = IncidenceTypeEvent;
-                    if ((*it).categoryList().contains(QLatin1StringView("seasonal"))) {
-                        entry.category = CategorySeasonal;
-                    } else if ((*it).categoryList().contains(QLatin1StringView("public"))) {
-                        entry.category = CategoryHoliday;
-                    } else {
-                        entry.category = CategoryOther;
-                    }
+                    entry.category = category;
                     entry.date = dt;
-                    entry.summary = (*it).name();
+                    entry.summary = holiday.name();
                     dateDiff(dt, entry.daysTo, entry.yearsOld);
                     entry.yearsOld = -1; // ignore age of holidays
                     entry.span = 1;
@@ -387,67 +391,19 @@ void SDSummaryWidget::createLabels()
         }
     }
 
-    QPalette todayPalette = palette();
-    KColorScheme::adjustBackground(todayPalette, KColorScheme::ActiveBackground, QPalette::Window);
+    const QBrush todayBrush = KColorScheme(QPalette::Active, KColorScheme::Window).background(KColorScheme::ActiveBackground);
 
     // Sort, then Print the Special Dates
     std::ranges::sort(mDates, eventLessThan);
 
+    QList<SummaryRow> rows;
     if (!mDates.isEmpty()) {
-        int counter = 0;
+        rows.reserve(mDates.size());
         QList<SDEntry>::ConstIterator addrIt;
         const QList<SDEntry>::ConstIterator addrEnd(mDates.end());
         for (addrIt = mDates.cbegin(); addrIt != addrEnd; ++addrIt) {
             const bool makeBold = (*addrIt).daysTo == 0; // i.e., today
 
-            // Pixmap
-            QImage icon_img;
-            QString icon_name;
-            KContacts::Picture pic;
-            switch ((*addrIt).category) {
-            case CategoryBirthday:
-                icon_name = QStringLiteral("view-calendar-birthday");
-                pic = (*addrIt).addressee.photo();
-                if (pic.isIntern() && !pic.data().isNull()) {
-                    QImage const img = pic.data();
-                    if (img.width() > img.height()) {
-                        icon_img = img.scaledToWidth(32);
-                    } else {
-                        icon_img = img.scaledToHeight(32);
-                    }
-                }
-                break;
-            case CategoryAnniversary:
-                icon_name = QStringLiteral("view-calendar-wedding-anniversary");
-                pic = (*addrIt).addressee.photo();
-                if (pic.isIntern() && !pic.data().isNull()) {
-                    QImage const img = pic.data();
-                    if (img.width() > img.height()) {
-                        icon_img = img.scaledToWidth(32);
-                    } else {
-                        icon_img = img.scaledToHeight(32);
-                    }
-                }
-                break;
-            case CategoryHoliday:
-                icon_name = QStringLiteral("view-calendar-holiday");
-                break;
-            case CategorySeasonal:
-            case CategoryOther:
-                icon_name = QStringLiteral("view-calendar-special-occasion");
-                break;
-            }
-            auto label = new QLabel(this);
-            if (icon_img.isNull()) {
-                label->setPixmap(QIcon::fromTheme(icon_name).pixmap(style()->pixelMetric(QStyle::PM_SmallIconSize)));
-            } else {
-                label->setPixmap(QPixmap::fromImage(icon_img));
-            }
-            label->setMaximumWidth(label->minimumSizeHint().width());
-            label->setAlignment(Qt::AlignVCenter);
-            mLayout->addWidget(label, counter, 0);
-            mLabels.append(label);
-
             // Event date
             QString datestr;
 
@@ -488,30 +444,14 @@ void SDSummaryWidget::createLabels()
                 datestr += QLatin1StringView(" -\n ") + endstr;
             }
 
-            label = new QLabel(datestr, this);
-            label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            mLayout->addWidget(label, counter, 1);
-            mLabels.append(label);
-            if (makeBold) {
-                QFont font = label->font();
-                font.setBold(true);
-                label->setFont(font);
-                label->setPalette(todayPalette);
-                label->setAutoFillBackground(true);
-            }
-
             // Countdown
-            label = new QLabel(this);
+            QString countdown;
             if ((*addrIt).daysTo == 0) {
-                label->setText(i18nc("@label", "now"));
+                countdown = i18nc("@label", "now");
             } else {
-                label->setText(i18ncp("@label", "in 1 day", "in %1 days", (*addrIt).daysTo));
+                countdown = i18ncp("@label", "in 1 day", "in %1 days", (*addrIt).daysTo);
             }
 
-            label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            mLayout->addWidget(label, counter, 2);
-            mLabels.append(label);
-
             // What
             QString what;
             switch ((*addrIt).category) {
@@ -531,103 +471,95 @@ void SDSummaryWidget::createLabels()
                 what = i18nc("@label", "Special Occasion");
                 break;
             }
-            label = new QLabel(this);
-            label->setText(what);
-            label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-            mLayout->addWidget(label, counter, 3);
-            mLabels.append(label);
+
+            // Age
+            const bool showAge = (*addrIt).category == CategoryBirthday || (*addrIt).category == CategoryAnniversary;
+            QString age;
+            if (showAge && (*addrIt).yearsOld > 0) {
+                age = i18ncp("@label", "one year", "%1 years", (*addrIt).yearsOld);
+            }
+
+            SummaryRow row;
+
+            // Pixmap
+            SummaryCell icon;
+            if ((*addrIt).photo.isNull()) {
+                QString icon_name;
+                switch ((*addrIt).category) {
+                case CategoryBirthday:
+                    icon_name = QStringLiteral("view-calendar-birthday");
+                    break;
+                case CategoryAnniversary:
+                    icon_name = QStringLiteral("view-calendar-wedding-anniversary");
+                    break;
+                case CategoryHoliday:
+                    icon_name = QStringLiteral("view-calendar-holiday");
+                    break;
+                case CategorySeasonal:
+                case CategoryOther:
+                    icon_name = QStringLiteral("view-calendar-special-occasion");
+                    break;
+                }
+                icon.pixmap = QIcon::fromTheme(icon_name).pixmap(style()->pixelMetric(QStyle::PM_SmallIconSize));
+            } else {
+                icon.pixmap = QPixmap::fromImage((*addrIt).photo);
+            }
+            row.cells.append(icon);
+
+            SummaryCell date{.text = datestr};
+            if (makeBold) {
+                date.bold = true;
+                date.background = todayBrush;
+            }
+            row.cells.append(date);
+
+            row.cells.append({.text = countdown});
+            row.cells.append({.text = what});
 
             // Description
+            row.subjectColumn = row.cells.size();
             if ((*addrIt).type == IncidenceTypeContact) {
-                auto urlLabel = new KUrlLabel(this);
-                urlLabel->setUrl((*addrIt).item.url(Akonadi::Item::UrlWithMimeType).url());
-                urlLabel->setText((*addrIt).addressee.realName());
-                urlLabel->setTextFormat(Qt::RichText);
-                urlLabel->setWordWrap(true);
-                urlLabel->setStatusTip(i18nc("@info:status", "Mail to:\"%1\"", urlLabel->text()));
-                mLayout->addWidget(urlLabel, counter, 4);
-                mLabels.append(urlLabel);
-                connect(urlLabel, &KUrlLabel::leftClickedUrl, this, [this, urlLabel] {
-                    mailContact(urlLabel->url());
-                });
-                connect(urlLabel, &KUrlLabel::rightClickedUrl, this, [this, urlLabel] {
-                    popupMenu(urlLabel->url());
-                });
+                row.cells.append({.text = (*addrIt).name, .richText = true});
+                row.url = (*addrIt).item.url(Akonadi::Item::UrlWithMimeType).url();
+                row.statusTip = i18nc("@info:status", "Mail to:\"%1\"", (*addrIt).name);
             } else {
-                label = new QLabel(this);
-                label->setText((*addrIt).summary);
-                label->setTextFormat(Qt::RichText);
-                mLayout->addWidget(label, counter, 4);
-                mLabels.append(label);
-                if (!(*addrIt).desc.isEmpty()) {
-                    label->setToolTip((*addrIt).desc);
-                }
+                row.cells.append({.text = (*addrIt).summary, .richText = true});
+                row.subjectIsLink = false;
+                row.toolTip = (*addrIt).desc;
             }
 
-            // Age
-            if ((*addrIt).category == CategoryBirthday || (*addrIt).category == CategoryAnniversary) {
-                label = new QLabel(this);
-                if ((*addrIt).yearsOld <= 0) {
-                    label->setText(QString());
-                } else {
-                    label->setText(i18ncp("@label", "one year", "%1 years", (*addrIt).yearsOld));
-                }
-                label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-                mLayout->addWidget(label, counter, 5);
-                mLabels.append(label);
+            if (showAge) {
+                row.cells.append({.text = age});
             }
 
-            counter++;
+            rows.append(std::move(row));
         }
-    } else {
-        auto label =
-            new QLabel(i18ncp("@label", "No special dates within the next 1 day", "No special dates pending within the next %1 days", mDaysAhead), this);
-        label->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
-        mLayout->addWidget(label, 0, 0);
-        mLabels.append(label);
     }
 
-    QList<QLabel *>::ConstIterator lit;
-    QList<QLabel *>::ConstIterator const endLit(mLabels.constEnd());
-    for (lit = mLabels.constBegin(); lit != endLit; ++lit) {
-        (*lit)->show();
-    }
-    setUpdatesEnabled(true);
+    mView->setPlaceholderText(
+        i18ncp("@label", "No special dates within the next 1 day", "No special dates pending within the next %1 days", mDaysAhead));
+    mView->setRows(std::move(rows));
 }
 
 void SDSummaryWidget::updateView()
 {
     mDates.clear();
 
-    /* KABC Birthdays are got through a ItemSearchJob/SPARQL Query
-     * I then added an ETM/CalendarModel because we need to search
-     * for calendar entries that have birthday/anniversary categories too.
-     *
-     * Also, we can't get KABC Anniversaries through nepomuk because the
-     * current S.D.O doesn't support it, so i also them through the ETM.
-     *
-     * So basically we have:
+    /* Special dates are collected from:
      * Calendar anniversaries - ETM
      * Calendar birthdays - ETM
-     * KABC birthdays - BirthdaySearchJob
-     * KABC anniversaries - ETM ( needs Birthday Agent running )
+     * KABC birthdays - ContactDatesIndex
+     * KABC anniversaries - ContactDatesIndex
      *
-     * We could remove thomas' BirthdaySearchJob and use the ETM for that
-     * but it has the advantage that we don't need a Birthday agent running.
+     * The ETM also holds the contact dates if the Birthday Agent is running;
+     * those events are skipped in favor of the contacts themselves.
      *
      **/
 
-    if (mShowBirthdaysFromKAB) {
-        if (!mJobRunning) {
-            auto job = new BirthdaySearchJob(this, mDaysAhead);
-            connect(job, &BirthdaySearchJob::result, this, &SDSummaryWidget::slotBirthdayJobFinished);
-            job->start();
-            mJobRunning = true;
-            // The result slot will trigger the rest of the update.
-        }
-    } else {
-        createLabels();
+    if (mContactDates) {
+        appendContactDates();
     }
+    createLabels();
 }
 
 void SDSummaryWidget::mailContact(const QString &url)
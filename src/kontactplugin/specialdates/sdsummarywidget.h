@@ -25,9 +25,10 @@ class Plugin;
 }
 
 class QDate;
-class QGridLayout;
-class QLabel;
 class SDEntry;
+class SummaryRefreshScheduler;
+class SummaryView;
+class ContactDatesIndex;
 class KJob;
 
 class SDSummaryWidget : public KontactInterface::Summary
@@ -50,7 +51,7 @@ private:
     void popupMenu(const QString &url);
     void mailContact(const QString &url);
     void viewContact(const QString &url);
-    void slotBirthdayJobFinished(KJob *job);
+    void appendContactDates();
     void slotItemFetchJobDone(KJob *job);
 
     int span(const KCalendarCore::Event::Ptr &event) const;
@@ -61,8 +62,8 @@ private:
 
     Akonadi::ETMCalendar::Ptr mCalendar;
 
-    QGridLayout *mLayout = nullptr;
-    QList<QLabel *> mLabels;
+    SummaryView *const mView;
+    SummaryRefreshScheduler *const mRefreshScheduler;
     KontactInterface::Plugin *const mPlugin;
 
     int mDaysAhead;
@@ -72,8 +73,8 @@ private:
     bool mShowAnniversariesFromCal = false;
     bool mShowHolidays = false;
     bool mShowSpecialsFromCal = false;
-    bool mJobRunning = false;
     QList<SDEntry> mDates;
+    ContactDatesIndex *mContactDates = nullptr;
 
     KHolidays::HolidayRegion *mHolidays = nullptr;
 };
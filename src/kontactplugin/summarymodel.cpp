@@ -0,0 +1,100 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "summarymodel.h"
+
+#include <QFont>
+
+#include <algorithm>
+
+SummaryModel::SummaryModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+SummaryModel::~SummaryModel() = default;
+
+void SummaryModel::setRows(QList<SummaryRow> rows)
+{
+    beginResetModel();
+    mRows = std::move(rows);
+    mColumnCount = 0;
+    for (const SummaryRow &row : std::as_const(mRows)) {
+        mColumnCount = std::max<int>(mColumnCount, row.cells.size());
+    }
+    endResetModel();
+}
+
+int SummaryModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : mRows.size();
+}
+
+int SummaryModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : mColumnCount;
+}
+
+QVariant SummaryModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return {};
+    }
+
+    SummaryRow &row = mRows[index.row()];
+    const bool isSubject = index.column() == row.subjectColumn;
+    switch (role) {
+    case Qt::ToolTipRole:
+    case Qt::StatusTipRole:
+        if (!isSubject) {
+            return {};
+        }
+        if (row.completeTips) {
+            const auto completeTips = std::move(row.completeTips);
+            row.completeTips = nullptr;
+            completeTips(row);
+        }
+        return role == Qt::ToolTipRole ? row.toolTip : row.statusTip;
+    case IsLinkRole:
+        return isSubject && row.subjectIsLink;
+    case UrlRole:
+        return row.url;
+    default:
+        break;
+    }
+
+    if (index.column() >= row.cells.size()) {
+        return {};
+    }
+    const SummaryCell &cell = row.cells.at(index.column());
+    switch (role) {
+    case Qt::DisplayRole:
+        return cell.text;
+    case Qt::DecorationRole:
+        return cell.pixmap.isNull() ? QVariant() : QVariant(cell.pixmap);
+    case Qt::FontRole:
+        if (cell.bold) {
+            QFont font;
+            font.setBold(true);
+            return font;
+        }
+        return {};
+    case Qt::BackgroundRole:
+        return cell.background.style() == Qt::NoBrush ? QVariant() : QVariant(cell.background);
+    case Qt::ForegroundRole:
+        return cell.foreground.style() == Qt::NoBrush ? QVariant() : QVariant(cell.foreground);
+    case Qt::TextAlignmentRole:
+        return QVariant::fromValue(cell.alignment);
+    case RichTextRole:
+        return cell.richText;
+    default:
+        return {};
+    }
+}
+
+#include "moc_summarymodel.cpp"
@@ -0,0 +1,85 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QBrush>
+#include <QList>
+#include <QPixmap>
+#include <QString>
+
+#include <functional>
+
+/**
+  One cell of a summary row.
+*/
+struct SummaryCell {
+    QString text;
+    QPixmap pixmap;
+    /** the text is HTML, as e.g. rich summaries of incidences are */
+    bool richText = false;
+    bool bold = false;
+    /** filled behind the cell if set, e.g. to highlight today's dates */
+    QBrush background;
+    /** the color of the text if set, e.g. to mark overdue to-dos */
+    QBrush foreground;
+    Qt::Alignment alignment = Qt::AlignLeft | Qt::AlignVCenter;
+};
+
+/**
+  One row of a summary, e.g. an appointment or a to-do.
+*/
+struct SummaryRow {
+    QList<SummaryCell> cells;
+    /** the cell naming the row's item, which shows the tips; -1 if none */
+    int subjectColumn = -1;
+    /** whether the subject cell acts as a link */
+    bool subjectIsLink = true;
+    /** passed to the handlers when the link is clicked */
+    QString url;
+    QString toolTip;
+    QString statusTip;
+    /**
+      Fills in the tips of the row when they are first asked for. Building
+      them is often expensive, and most rows are never pointed at.
+    */
+    std::function<void(SummaryRow &row)> completeTips;
+};
+
+/**
+  The rows shown by a SummaryView.
+
+  @short Table model of a Kontact summary
+*/
+class SummaryModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Roles {
+        RichTextRole = Qt::UserRole + 1, ///< whether the display text is HTML
+        IsLinkRole, ///< whether the cell acts as a link
+        UrlRole, ///< the url of the row
+    };
+
+    explicit SummaryModel(QObject *parent = nullptr);
+    ~SummaryModel() override;
+
+    /**
+      Replaces all rows.
+    */
+    void setRows(QList<SummaryRow> rows);
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = {}) const override;
+    [[nodiscard]] int columnCount(const QModelIndex &parent = {}) const override;
+    [[nodiscard]] QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    // Mutable so that the tips can be completed on demand
+    mutable QList<SummaryRow> mRows;
+    int mColumnCount = 0;
+};
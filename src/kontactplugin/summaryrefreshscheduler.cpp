@@ -0,0 +1,60 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "summaryrefreshscheduler.h"
+
+#include <QEvent>
+#include <QWidget>
+
+namespace
+{
+// Minimum delay between two refreshes of a summary
+constexpr int refreshInterval = 250;
+}
+
+SummaryRefreshScheduler::SummaryRefreshScheduler(QWidget *summary)
+    : QObject(summary)
+    , mSummary(summary)
+{
+    mTimer.setSingleShot(true);
+    mTimer.setInterval(refreshInterval);
+    connect(&mTimer, &QTimer::timeout, this, &SummaryRefreshScheduler::refresh);
+    mSummary->installEventFilter(this);
+}
+
+SummaryRefreshScheduler::~SummaryRefreshScheduler() = default;
+
+void SummaryRefreshScheduler::scheduleRefresh()
+{
+    mPending = true;
+    // Not restarted on every request, so a steady stream of changes still
+    // refreshes the summary once per interval
+    if (mSummary->isVisible() && !mTimer.isActive()) {
+        mTimer.start();
+    }
+}
+
+bool SummaryRefreshScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == mSummary && event->type() == QEvent::Show && mPending && !mTimer.isActive()) {
+        mTimer.start();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void SummaryRefreshScheduler::refresh()
+{
+    if (!mSummary->isVisible()) {
+        // Stays pending until the summary is shown again
+        return;
+    }
+    mPending = false;
+    Q_EMIT refreshRequested();
+}
+
+#include "moc_summaryrefreshscheduler.cpp"
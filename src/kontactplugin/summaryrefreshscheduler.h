@@ -0,0 +1,50 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+/**
+  Coalesces the refresh requests of a summary widget.
+
+  Calendars report every single item change, e.g. thousands of them during
+  a synchronization. All requests made within one interval result in a
+  single refreshRequested() signal. While the summary is hidden nothing is
+  refreshed; a pending refresh is done once it is shown again.
+
+  @short Refresh throttling for the Kontact summaries
+*/
+class SummaryRefreshScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SummaryRefreshScheduler(QWidget *summary);
+    ~SummaryRefreshScheduler() override;
+
+    /**
+      Requests a refresh of the summary.
+    */
+    void scheduleRefresh();
+
+Q_SIGNALS:
+    /**
+      Emitted when the summary should rebuild its contents.
+    */
+    void refreshRequested();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void refresh();
+
+    QWidget *const mSummary;
+    QTimer mTimer;
+    bool mPending = false;
+};
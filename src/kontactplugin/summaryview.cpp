@@ -0,0 +1,256 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "summaryview.h"
+
+#include <QAbstractTextDocumentLayout>
+#include <QApplication>
+#include <QContextMenuEvent>
+#include <QHeaderView>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QStyledItemDelegate>
+#include <QTextDocument>
+#include <QtMath>
+
+#include <algorithm>
+
+namespace
+{
+// Rich text cells lay out a whole QTextDocument to be measured, so the
+// column widths only take this many rows of them into account
+constexpr int richTextSampleRows = 50;
+
+// Paints links in the link color and HTML cells as rich text
+class SummaryDelegate : public QStyledItemDelegate
+{
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override
+    {
+        QStyleOptionViewItem opt = option;
+        initStyleOption(&opt, index);
+        // The summaries never show selections
+        opt.state &= ~(QStyle::State_Selected | QStyle::State_HasFocus);
+        if (index.data(SummaryModel::IsLinkRole).toBool()) {
+            opt.palette.setColor(QPalette::Text, opt.palette.color(QPalette::Link));
+            if (opt.state & QStyle::State_MouseOver) {
+                opt.font.setUnderline(true);
+            }
+        }
+
+        QStyle *style = opt.widget ? opt.widget->style() : QApplication::style();
+        if (!index.data(SummaryModel::RichTextRole).toBool()) {
+            style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, opt.widget);
+            return;
+        }
+
+        QTextDocument doc;
+        setupDocument(doc, opt);
+        opt.text.clear();
+        style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, opt.widget);
+
+        const QRect textRect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, opt.widget);
+        const int top = textRect.top() + std::max(0, (textRect.height() - qCeil(doc.size().height())) / 2);
+        painter->save();
+        painter->translate(textRect.left(), top);
+        QAbstractTextDocumentLayout::PaintContext context;
+        context.palette = opt.palette;
+        context.clip = QRectF(0, 0, textRect.width(), textRect.height());
+        painter->setClipRect(context.clip);
+        doc.documentLayout()->draw(painter, context);
+        painter->restore();
+    }
+
+    [[nodiscard]] QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override
+    {
+        if (!index.data(SummaryModel::RichTextRole).toBool()) {
+            return QStyledItemDelegate::sizeHint(option, index);
+        }
+
+        QStyleOptionViewItem opt = option;
+        initStyleOption(&opt, index);
+        QTextDocument doc;
+        setupDocument(doc, opt);
+        opt.text.clear();
+        const QSize frame = QStyledItemDelegate::sizeHint(opt, QModelIndex());
+        return {frame.width() + qCeil(doc.idealWidth()), std::max(frame.height(), qCeil(doc.size().height()))};
+    }
+
+private:
+    static void setupDocument(QTextDocument &doc, const QStyleOptionViewItem &opt)
+    {
+        doc.setDocumentMargin(0);
+        doc.setDefaultFont(opt.font);
+        doc.setHtml(opt.text);
+    }
+};
+}
+
+SummaryView::SummaryView(QWidget *parent)
+    : QTableView(parent)
+    , mModel(new SummaryModel(this))
+{
+    setModel(mModel);
+    setItemDelegate(new SummaryDelegate(this));
+
+    horizontalHeader()->hide();
+    horizontalHeader()->setStretchLastSection(true);
+    verticalHeader()->hide();
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setMinimumSectionSize(0);
+    setShowGrid(false);
+    setWordWrap(false);
+    setFrameShape(QFrame::NoFrame);
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setFocusPolicy(Qt::NoFocus);
+
+    // As tall as the rows; the summary page scrolls
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+
+    // Blend in with the summary page and track the pointer for the links
+    viewport()->setAutoFillBackground(false);
+    viewport()->setAttribute(Qt::WA_Hover);
+    setMouseTracking(true);
+}
+
+SummaryView::~SummaryView() = default;
+
+void SummaryView::setRows(QList<SummaryRow> rows)
+{
+    mModel->setRows(std::move(rows));
+    updateSectionSizes();
+    updateGeometry();
+    viewport()->update();
+}
+
+void SummaryView::updateSectionSizes()
+{
+    const int rowCount = mModel->rowCount();
+    const int columnCount = mModel->columnCount();
+    if (rowCount == 0) {
+        return;
+    }
+
+    QStyleOptionViewItem option;
+    initViewItemOption(&option);
+    QAbstractItemDelegate *delegate = itemDelegate();
+
+    // The rows of a summary all hold the same kind of cells, so the first
+    // row gives the height of all of them
+    int rowHeight = 0;
+    for (int column = 0; column < columnCount; ++column) {
+        rowHeight = std::max(rowHeight, delegate->sizeHint(option, mModel->index(0, column)).height());
+    }
+    verticalHeader()->setDefaultSectionSize(rowHeight);
+
+    // One pass over the cells; the rows are not measured again
+    QList<int> columnWidths(columnCount, 0);
+    for (int row = 0; row < rowCount; ++row) {
+        for (int column = 0; column < columnCount; ++column) {
+            const QModelIndex index = mModel->index(row, column);
+            if (row >= richTextSampleRows && index.data(SummaryModel::RichTextRole).toBool()) {
+                continue;
+            }
+            const int width = delegate->sizeHint(option, index).width();
+            columnWidths[column] = std::max(columnWidths[column], width);
+        }
+    }
+    for (int column = 0; column < columnCount; ++column) {
+        horizontalHeader()->resizeSection(column, columnWidths.at(column));
+    }
+}
+
+void SummaryView::setPlaceholderText(const QString &text)
+{
+    if (mPlaceholderText != text) {
+        mPlaceholderText = text;
+        updateGeometry();
+        viewport()->update();
+    }
+}
+
+QSize SummaryView::sizeHint() const
+{
+    const int frame = 2 * frameWidth();
+    if (mModel->rowCount() == 0) {
+        return {fontMetrics().horizontalAdvance(mPlaceholderText) + frame, fontMetrics().height() + frame};
+    }
+    return {horizontalHeader()->length() + frame, mModel->rowCount() * verticalHeader()->defaultSectionSize() + frame};
+}
+
+QSize SummaryView::minimumSizeHint() const
+{
+    return {QTableView::minimumSizeHint().width(), sizeHint().height()};
+}
+
+void SummaryView::mouseMoveEvent(QMouseEvent *event)
+{
+    QTableView::mouseMoveEvent(event);
+    if (linkAt(event->position().toPoint()).isValid()) {
+        viewport()->setCursor(Qt::PointingHandCursor);
+    } else {
+        viewport()->unsetCursor();
+    }
+}
+
+void SummaryView::mouseReleaseEvent(QMouseEvent *event)
+{
+    QTableView::mouseReleaseEvent(event);
+    if (event->button() == Qt::LeftButton) {
+        const QModelIndex index = linkAt(event->position().toPoint());
+        if (index.isValid()) {
+            Q_EMIT linkClicked(index.data(SummaryModel::UrlRole).toString());
+        }
+    }
+}
+
+void SummaryView::contextMenuEvent(QContextMenuEvent *event)
+{
+    const QModelIndex index = linkAt(event->pos());
+    if (index.isValid()) {
+        Q_EMIT linkRightClicked(index.data(SummaryModel::UrlRole).toString());
+        event->accept();
+    } else {
+        QTableView::contextMenuEvent(event);
+    }
+}
+
+void SummaryView::changeEvent(QEvent *event)
+{
+    QTableView::changeEvent(event);
+    if (event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange) {
+        updateSectionSizes();
+        updateGeometry();
+    }
+}
+
+void SummaryView::paintEvent(QPaintEvent *event)
+{
+    if (mModel->rowCount() == 0) {
+        QPainter painter(viewport());
+        painter.drawText(viewport()->rect(), Qt::AlignCenter, mPlaceholderText);
+        return;
+    }
+    QTableView::paintEvent(event);
+}
+
+QModelIndex SummaryView::linkAt(const QPoint &pos) const
+{
+    const QModelIndex index = indexAt(pos);
+    if (index.isValid() && index.data(SummaryModel::IsLinkRole).toBool()) {
+        return index;
+    }
+    return {};
+}
+
+#include "moc_summaryview.cpp"
@@ -0,0 +1,69 @@
+/*
+  This file is part of Kontact.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+#pragma once
+
+#include "summarymodel.h"
+
+#include <QTableView>
+
+/**
+  Shows the rows of a Kontact summary.
+
+  All rows are painted by a single view, which only paints the rows that
+  are visible. The number of widgets does not grow with the number of
+  rows. All rows have the same height, so the view is as tall as its rows
+  without measuring them, leaving the scrolling to the summary page.
+
+  The subject cell of a row shows the row's tips when hovered. If it is a
+  link it behaves like KUrlLabel: it is drawn in the link color and
+  reports clicks through linkClicked() and linkRightClicked().
+
+  @short Row view of a Kontact summary
+*/
+class SummaryView : public QTableView
+{
+    Q_OBJECT
+public:
+    explicit SummaryView(QWidget *parent = nullptr);
+    ~SummaryView() override;
+
+    /**
+      Replaces the rows shown.
+    */
+    void setRows(QList<SummaryRow> rows);
+
+    /**
+      Sets the text shown instead of the rows when there are none.
+    */
+    void setPlaceholderText(const QString &text);
+
+    [[nodiscard]] QSize sizeHint() const override;
+    [[nodiscard]] QSize minimumSizeHint() const override;
+
+Q_SIGNALS:
+    void linkClicked(const QString &url);
+    void linkRightClicked(const QString &url);
+
+protected:
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;
+    void changeEvent(QEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    /**
+      Sizes the columns from the delegate and gives all rows the height of
+      the first one.
+    */
+    void updateSectionSizes();
+    [[nodiscard]] QModelIndex linkAt(const QPoint &pos) const;
+
+    SummaryModel *const mModel;
+    QString mPlaceholderText;
+};
@@ -19,6 +19,7 @@
 #include "kocore.h"
 #include "plugininterface/korganizerplugininterface.h"
 #include "prefs/koprefs.h"
+#include "startuptrace.h"
 
 #include <Libkdepim/ProgressStatusBarWidget>
 #include <Libkdepim/StatusbarProgressWidget>
@@ -117,17 +118,34 @@ KOrganizer::~KOrganizer()
 
 void KOrganizer::init(bool document)
 {
+    KOrg::StartupTrace::Phase phase("KOrganizer::init");
     setHasDocument(document);
 
     // Create calendar object, which manages all calendar information associated
     // with this calendar view window.
     mActionManager->createCalendarAkonadi();
 
-    mActionManager->init();
+    {
+        KOrg::StartupTrace::Phase phase("ActionManager::init");
+        mActionManager->init();
+    }
+
+    KOrg::StartupTrace::afterFirstPaint(this, []() {
+        KOrg::StartupTrace::mark("first paint");
+        KOrg::StartupTrace::finish();
+    });
 
-    KOrganizerPluginInterface::self()->setActionCollection(actionCollection());
-    KOrganizerPluginInterface::self()->initializePlugins();
-    initActions();
+    // The plugin actions have to exist before createGUI() plugs the actions of the ui files
+    {
+        KOrg::StartupTrace::Phase phase("plugins");
+        KOrganizerPluginInterface::self()->setActionCollection(actionCollection());
+        KOrganizerPluginInterface::self()->initializePlugins();
+    }
+
+    {
+        KOrg::StartupTrace::Phase phase("KOrganizer::initActions");
+        initActions();
+    }
     readSettings();
 
     QStatusBar *bar = statusBar();
@@ -28,17 +28,30 @@
 
 #include <KActionCollection>
 #include <KMessageBox>
+#include <QSignalBlocker>
 #include <QTabWidget>
 
 #include <KSharedConfig>
 #include <QAction>
 #include <QStackedWidget>
 
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+// Views hidden for longer stop following the calendars until shown again
+constexpr std::chrono::milliseconds detachDelay = std::chrono::minutes(5);
+}
+
 KOViewManager::KOViewManager(CalendarView *mainView)
     : mMainView(mainView)
 {
-    connect(mainView, &CalendarView::calendarAdded, this, &KOViewManager::addCalendar);
-    connect(mainView, &CalendarView::calendarRemoved, this, &KOViewManager::removeCalendar);
+    connect(mainView, &CalendarView::calendarsChanged, this, &KOViewManager::changeCalendars);
+
+    mClock.start();
+    mDetachTimer.setSingleShot(true);
+    connect(&mDetachTimer, &QTimer::timeout, this, &KOViewManager::detachHiddenViews);
 }
 
 KOViewManager::~KOViewManager() = default;
@@ -195,6 +208,12 @@ void KOViewManager::showView(KOrg::BaseView *view)
         return;
     }
 
+    if (mCurrentView) {
+        viewHidden(mCurrentView);
+    }
+    if (view) {
+        attachView(view);
+    }
     mCurrentView = view;
     mMainView->updateHighlightModes();
 
@@ -320,9 +339,6 @@ void KOViewManager::connectView(KOrg::BaseView *view)
     connect(view, &BaseView::startMultiModify, mMainView, &CalendarView::startMultiModify);
     connect(view, &BaseView::endMultiModify, mMainView, &CalendarView::endMultiModify);
 
-    connect(mMainView, &CalendarView::calendarAdded, view, &BaseView::calendarAdded);
-    connect(mMainView, &CalendarView::calendarRemoved, view, &BaseView::calendarRemoved);
-
     view->setIncidenceChanger(mMainView->incidenceChanger());
 }
 
@@ -404,6 +420,55 @@ void KOViewManager::addView(KOrg::BaseView *view, bool isTab)
     for (const auto &calendar : std::as_const(mCalendars)) {
         view->calendarAdded(calendar);
     }
+    // Hidden until shown, e.g. the agenda view in a tab which is not current
+    viewHidden(view);
+}
+
+void KOViewManager::viewHidden(KOrg::BaseView *view)
+{
+    mHiddenSince.insert(view, mClock.elapsed());
+    if (!mDetachTimer.isActive()) {
+        mDetachTimer.start(detachDelay);
+    }
+}
+
+void KOViewManager::attachView(KOrg::BaseView *view)
+{
+    mHiddenSince.remove(view);
+    if (!mDetachedViews.remove(view)) {
+        return;
+    }
+
+    for (const auto &calendar : std::as_const(mCalendars)) {
+        view->calendarAdded(calendar);
+    }
+    // Catch up with the changes made while the view was detached
+    view->setChanges(view->changes() | EventViews::EventView::ResourcesChanged);
+}
+
+void KOViewManager::detachHiddenViews()
+{
+    const qint64 now = mClock.elapsed();
+    qint64 nextDetach = -1;
+    for (auto it = mHiddenSince.begin(); it != mHiddenSince.end();) {
+        const qint64 remaining = detachDelay.count() - (now - it.value());
+        if (remaining > 0) {
+            nextDetach = nextDetach < 0 ? remaining : std::min(nextDetach, remaining);
+            ++it;
+            continue;
+        }
+
+        KOrg::BaseView *view = it.key();
+        for (const auto &calendar : std::as_const(mCalendars)) {
+            view->calendarRemoved(calendar);
+        }
+        mDetachedViews.insert(view);
+        it = mHiddenSince.erase(it);
+    }
+
+    if (nextDetach >= 0) {
+        mDetachTimer.start(std::chrono::milliseconds(nextDetach));
+    }
 }
 
 void KOViewManager::viewActionEnable(QObject *obj)
@@ -486,7 +551,6 @@ void KOViewManager::showAgendaView()
     const bool showMerged = showBoth || KOPrefs::instance()->agendaViewCalendarDisplay() == KOPrefs::CalendarsMerged;
     const bool showSideBySide = showBoth || KOPrefs::instance()->agendaViewCalendarDisplay() == KOPrefs::CalendarsSideBySide;
 
-    QWidget *parent = mMainView->viewStack();
     if (showBoth) {
         if (!mAgendaViewTabs) {
             mAgendaViewTabs = new QTabWidget(mMainView->viewStack());
@@ -494,45 +558,31 @@ void KOViewManager::showAgendaView()
             mMainView->viewStack()->addWidget(mAgendaViewTabs);
 
             KConfigGroup const viewConfig = KSharedConfig::openConfig()->group(QStringLiteral("Views"));
-            mAgendaViewTabIndex = viewConfig.readEntry("Agenda View Tab Index", 0);
+            mAgendaViewTabIndex = std::clamp(viewConfig.readEntry("Agenda View Tab Index", 0), 0, agendaViewTabCount - 1);
         }
-        parent = mAgendaViewTabs;
-    }
-
-    if (showMerged) {
-        if (!mAgendaView) {
-            mAgendaView = new KOAgendaView(parent);
-            mAgendaView->setIdentifier("DefaultAgendaView");
-
-            addView(mAgendaView, showBoth);
-
-            connect(mAgendaView, &KOAgendaView::zoomViewHorizontally, this, [this](const QDate &d, int n) {
-                mMainView->dateNavigator()->selectDates(d, n, QDate());
-            });
-            auto config = KSharedConfig::openConfig();
-            mAgendaView->readSettings(config.data());
+        const QSignalBlocker blocker(mAgendaViewTabs);
+        for (int index = 0; index < agendaViewTabCount; ++index) {
+            setUpAgendaViewTab(index);
         }
-        if (showBoth && mAgendaViewTabs->indexOf(mAgendaView) < 0) {
-            mAgendaViewTabs->addTab(mAgendaView, i18n("Merged calendar"));
-        } else if (!showBoth && mMainView->viewStack()->indexOf(mAgendaView) < 0) {
-            mAgendaView->setParent(parent);
-            mMainView->viewStack()->addWidget(mAgendaView);
+        mAgendaViewTabs->setCurrentIndex(mAgendaViewTabIndex);
+    } else {
+        QWidget *parent = mMainView->viewStack();
+        if (showMerged) {
+            if (!mAgendaView) {
+                createAgendaView(parent, false);
+            } else if (mMainView->viewStack()->indexOf(mAgendaView) < 0) {
+                mAgendaView->setParent(parent);
+                mMainView->viewStack()->addWidget(mAgendaView);
+            }
         }
-    }
 
-    if (showSideBySide) {
-        if (!mAgendaSideBySideView) {
-            mAgendaSideBySideView = new KOMultiAgendaView(mMainView, parent);
-            mAgendaSideBySideView->setIdentifier("DefaultAgendaSideBySideView");
-            mAgendaSideBySideView->setCollectionSelectionProxyModel(mMainView->calendar()->checkableProxyModel());
-            addView(mAgendaSideBySideView, showBoth);
-        }
-        if (showBoth && mAgendaViewTabs->indexOf(mAgendaSideBySideView) < 0) {
-            mAgendaViewTabs->addTab(mAgendaSideBySideView, i18n("Calendars Side by Side"));
-            mAgendaViewTabs->setCurrentIndex(mAgendaViewTabIndex);
-        } else if (!showBoth && mMainView->viewStack()->indexOf(mAgendaSideBySideView) < 0) {
-            mAgendaSideBySideView->setParent(parent);
-            mMainView->viewStack()->addWidget(mAgendaSideBySideView);
+        if (showSideBySide) {
+            if (!mAgendaSideBySideView) {
+                createAgendaSideBySideView(parent, false);
+            } else if (mMainView->viewStack()->indexOf(mAgendaSideBySideView) < 0) {
+                mAgendaSideBySideView->setParent(parent);
+                mMainView->viewStack()->addWidget(mAgendaSideBySideView);
+            }
         }
     }
 
@@ -548,6 +598,58 @@ void KOViewManager::showAgendaView()
     viewActionEnable(viewToAction(QStringLiteral("Agenda"), mRangeMode));
 }
 
+void KOViewManager::createAgendaView(QWidget *parent, bool isTab)
+{
+    mAgendaView = new KOAgendaView(parent);
+    mAgendaView->setIdentifier("DefaultAgendaView");
+
+    addView(mAgendaView, isTab);
+
+    connect(mAgendaView, &KOAgendaView::zoomViewHorizontally, this, [this](const QDate &d, int n) {
+        mMainView->dateNavigator()->selectDates(d, n, QDate());
+    });
+    auto config = KSharedConfig::openConfig();
+    mAgendaView->readSettings(config.data());
+}
+
+void KOViewManager::createAgendaSideBySideView(QWidget *parent, bool isTab)
+{
+    mAgendaSideBySideView = new KOMultiAgendaView(mMainView, parent);
+    mAgendaSideBySideView->setIdentifier("DefaultAgendaSideBySideView");
+    mAgendaSideBySideView->setCollectionSelectionProxyModel(mMainView->calendar()->checkableProxyModel());
+    addView(mAgendaSideBySideView, isTab);
+}
+
+void KOViewManager::setUpAgendaViewTab(int index)
+{
+    // The view of a tab which is not current is only created when the tab
+    // is selected, until then the tab holds a placeholder
+    KOrg::BaseView *view = index == 0 ? static_cast<KOrg::BaseView *>(mAgendaView) : mAgendaSideBySideView;
+    if (!view && index == mAgendaViewTabIndex) {
+        if (index == 0) {
+            createAgendaView(mAgendaViewTabs, true);
+            view = mAgendaView;
+        } else {
+            createAgendaSideBySideView(mAgendaViewTabs, true);
+            view = mAgendaSideBySideView;
+        }
+    }
+
+    QWidget *current = index < mAgendaViewTabs->count() ? mAgendaViewTabs->widget(index) : nullptr;
+    const bool currentIsPlaceholder = current && !qobject_cast<KOrg::BaseView *>(current);
+    if ((view && current == view) || (!view && currentIsPlaceholder)) {
+        return;
+    }
+    if (current) {
+        mAgendaViewTabs->removeTab(index);
+        if (currentIsPlaceholder) {
+            delete current;
+        }
+    }
+    const QString label = index == 0 ? i18n("Merged calendar") : i18n("Calendars Side by Side");
+    mAgendaViewTabs->insertTab(index, view ? static_cast<QWidget *>(view) : new QWidget(mAgendaViewTabs), label);
+}
+
 void KOViewManager::selectDay()
 {
     showAgendaView();
@@ -686,6 +788,13 @@ void KOViewManager::currentAgendaViewTabChanged(int index)
     KConfigGroup viewConfig(config, QStringLiteral("Views"));
     viewConfig.writeEntry("Agenda View Tab Index", mAgendaViewTabs->currentIndex());
 
+    if (index > -1 && index < agendaViewTabCount) {
+        mAgendaViewTabIndex = index;
+        const QSignalBlocker blocker(mAgendaViewTabs);
+        setUpAgendaViewTab(index);
+        mAgendaViewTabs->setCurrentIndex(index);
+    }
+
     if (index > -1) {
         viewActionEnable(sender());
         goMenu(true);
@@ -719,16 +828,28 @@ bool KOViewManager::agendaIsSelected() const
     return mCurrentView == mAgendaView || mCurrentView == mAgendaSideBySideView || (mAgendaViewTabs && mCurrentView == mAgendaViewTabs->currentWidget());
 }
 
-void KOViewManager::addCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
+void KOViewManager::changeCalendars(const QList<Akonadi::CollectionCalendar::Ptr> &added, const QList<Akonadi::CollectionCalendar::Ptr> &removed)
 {
-    mCalendars.push_back(calendar);
-}
-
-void KOViewManager::removeCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
-{
-    if (mCalendars.contains(calendar)) {
+    for (const auto &calendar : removed) {
         mCalendars.removeAll(calendar);
     }
+    mCalendars.append(added);
+
+    for (KOrg::BaseView *view : std::as_const(mViews)) {
+        if (mDetachedViews.contains(view)) {
+            continue;
+        }
+        // The visible view repaints once, after all calendars were handed over
+        const bool updatesEnabled = view->updatesEnabled();
+        view->setUpdatesEnabled(false);
+        for (const auto &calendar : removed) {
+            view->calendarRemoved(calendar);
+        }
+        for (const auto &calendar : added) {
+            view->calendarAdded(calendar);
+        }
+        view->setUpdatesEnabled(updatesEnabled);
+    }
 }
 
 #include "moc_koviewmanager.cpp"
@@ -14,8 +14,12 @@
 #include <KCalendarCore/IncidenceBase> //for KCalendarCore::DateList typedef
 
 #include <QDate>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QList>
 #include <QObject>
+#include <QSet>
+#include <QTimer>
 
 class CalendarView;
 class KOAgendaView;
@@ -43,6 +47,9 @@ class QTabWidget;
 /**
   This class manages the views of the calendar. It owns the objects and handles
   creation and selection.
+
+  Views are created when they are shown first. A view which stays hidden for
+  a while no longer follows the calendars; it catches up when shown again.
 */
 class KOViewManager : public QObject
 {
@@ -158,12 +165,18 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void currentAgendaViewTabChanged(int index);
-    void addCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
-    void removeCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
+    void changeCalendars(const QList<Akonadi::CollectionCalendar::Ptr> &added, const QList<Akonadi::CollectionCalendar::Ptr> &removed);
 
 private:
     KActionCollection *getActionCollection() const;
     QWidget *widgetForView(KOrg::BaseView *) const;
+    void createAgendaView(QWidget *parent, bool isTab);
+    void createAgendaSideBySideView(QWidget *parent, bool isTab);
+    void setUpAgendaViewTab(int index);
+    void viewHidden(KOrg::BaseView *view);
+    void attachView(KOrg::BaseView *view);
+    void detachHiddenViews();
+
     QList<KOrg::BaseView *> mViews;
     CalendarView *const mMainView;
     QList<Akonadi::CollectionCalendar::Ptr> mCalendars;
@@ -179,9 +192,18 @@ private:
     KOrg::BaseView *mCurrentView = nullptr;
 
     KOrg::BaseView *mLastEventView = nullptr;
+    /** the merged and the side by side agenda view, when both are shown */
     QTabWidget *mAgendaViewTabs = nullptr;
+    static constexpr int agendaViewTabCount = 2;
     int mAgendaViewTabIndex = 0;
     QAction *mLastViewAction = nullptr;
 
     RangeMode mRangeMode = NO_RANGE;
+
+    /** when the hidden views were hidden, on mClock */
+    QHash<KOrg::BaseView *, qint64> mHiddenSince;
+    /** the views which do not follow the calendars */
+    QSet<KOrg::BaseView *> mDetachedViews;
+    QElapsedTimer mClock;
+    QTimer mDetachTimer;
 };
@@ -8,10 +8,12 @@
 */
 
 #include "aboutdata.h"
+#include "batchmode.h"
 #include "koapp.h"
 #include "korganizer.h"
 #include "korganizer_debug.h"
 #include "korganizer_options.h"
+#include "startuptrace.h"
 #include <KConfig>
 #include <KConfigGroup>
 #include <KCrash>
@@ -27,6 +29,14 @@
 
 int main(int argc, char **argv)
 {
+    KOrg::StartupTrace::mark("main");
+
+    // Batch mode runs without widgets and without a unique instance
+    if (BatchMode::isRequested(argc, argv)) {
+        KOrganizerApp::setProductId();
+        return BatchMode::run(argc, argv);
+    }
+
     KIconTheme::initTheme();
     KOrganizerApp app(argc, &argv);
     KStyleManager::initStyle();
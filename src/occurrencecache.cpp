@@ -0,0 +1,75 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "occurrencecache.h"
+
+#include <KCalendarCore/Recurrence>
+
+namespace
+{
+// Every navigator and summary asks for its own window; older windows are
+// usually the ones scrolled away from
+constexpr qsizetype maximumWindowsPerIncidence = 8;
+}
+
+OccurrenceCache::OccurrenceCache() = default;
+
+OccurrenceCache::~OccurrenceCache() = default;
+
+QList<QDateTime> OccurrenceCache::timesInInterval(const KCalendarCore::Incidence::Ptr &incidence, const QDateTime &start, const QDateTime &end)
+{
+    Q_ASSERT(incidence);
+    if (!incidence->recurs()) {
+        return incidence->recurrence()->timesInInterval(start, end);
+    }
+
+    QList<Expansion> &expansions = mExpansions[incidence->instanceIdentifier()];
+    for (qsizetype i = 0; i < expansions.size(); ++i) {
+        const Expansion &expansion = expansions.at(i);
+        if (expansion.incidence == incidence.data() && expansion.start == start && expansion.end == end) {
+            if (i != expansions.size() - 1) {
+                expansions.move(i, expansions.size() - 1);
+            }
+            return expansions.constLast().times;
+        }
+    }
+
+    if (expansions.size() >= maximumWindowsPerIncidence) {
+        expansions.removeFirst();
+    }
+    expansions.append({incidence.data(), start, end, incidence->recurrence()->timesInInterval(start, end)});
+    return expansions.constLast().times;
+}
+
+void OccurrenceCache::invalidate(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    if (incidence) {
+        mExpansions.remove(incidence->instanceIdentifier());
+    }
+}
+
+void OccurrenceCache::clear()
+{
+    mExpansions.clear();
+}
+
+void OccurrenceCache::calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    invalidate(incidence);
+}
+
+void OccurrenceCache::calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence)
+{
+    invalidate(incidence);
+}
+
+void OccurrenceCache::calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar)
+{
+    Q_UNUSED(calendar)
+    invalidate(incidence);
+}
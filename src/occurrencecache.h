@@ -0,0 +1,76 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "korganizerprivate_export.h"
+
+#include <KCalendarCore/Calendar>
+#include <KCalendarCore/Incidence>
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+
+/**
+  Remembers the occurrences of recurring incidences within date windows.
+
+  Several widgets show the same recurring series for the same weeks, e.g. the
+  date navigators and the Kontact summaries. They ask the cache instead of
+  expanding the recurrence themselves, so each (series, window) pair is only
+  expanded once until the incidence changes.
+
+  Entries are dropped per incidence when the cache is told about a change,
+  either explicitly through invalidate() or by registering the cache as an
+  observer of the calendar holding the incidences.
+
+  @short Cache of expanded recurrences
+*/
+class KORGANIZERPRIVATE_EXPORT OccurrenceCache : public KCalendarCore::Calendar::CalendarObserver
+{
+public:
+    OccurrenceCache();
+    ~OccurrenceCache() override;
+
+    /**
+      Returns the start times of the occurrences of @p incidence between
+      @p start and @p end, like Recurrence::timesInInterval() does.
+    */
+    [[nodiscard]] QList<QDateTime> timesInInterval(const KCalendarCore::Incidence::Ptr &incidence, const QDateTime &start, const QDateTime &end);
+
+    /**
+      Forgets all windows expanded for @p incidence.
+    */
+    void invalidate(const KCalendarCore::Incidence::Ptr &incidence);
+
+    /**
+      Forgets everything, e.g. when a whole calendar was reloaded.
+    */
+    void clear();
+
+protected:
+    /**
+     *  Reimplemented from KCalendarCore::Calendar::CalendarObserver
+     */
+    void calendarIncidenceAdded(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceChanged(const KCalendarCore::Incidence::Ptr &incidence) override;
+    void calendarIncidenceDeleted(const KCalendarCore::Incidence::Ptr &incidence, const KCalendarCore::Calendar *calendar) override;
+
+private:
+    struct Expansion {
+        // The incidence the times were computed for; a replaced incidence
+        // object with the same identifier must not reuse them
+        const KCalendarCore::Incidence *incidence = nullptr;
+        QDateTime start;
+        QDateTime end;
+        QList<QDateTime> times;
+    };
+
+    /** windows expanded for each instance identifier, most recently used last */
+    QHash<QString, QList<Expansion>> mExpansions;
+};
@@ -0,0 +1,218 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#include "startuptrace.h"
+#include "korganizer_startup_debug.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QTimer>
+#include <QWidget>
+#include <QWindow>
+
+using namespace KOrg;
+
+namespace
+{
+// Deferred work of windows which are not shown runs after this delay anyway
+constexpr int firstPaintTimeout = 5000;
+
+struct TraceEvent {
+    QByteArray name;
+    qint64 start; // in microseconds
+    qint64 duration; // in microseconds, -1 for an instant
+};
+
+struct Trace {
+    Trace()
+        : fileName(qEnvironmentVariable("KORGANIZER_STARTUP_TRACE"))
+    {
+        timer.start();
+    }
+
+    [[nodiscard]] qint64 now() const
+    {
+        return timer.nsecsElapsed() / 1000;
+    }
+
+    void record(const char *name, qint64 start, qint64 duration)
+    {
+        if (duration < 0) {
+            qCDebug(KORGANIZER_STARTUP_LOG, "%s at %.1f ms", name, start / 1000.0);
+        } else {
+            qCDebug(KORGANIZER_STARTUP_LOG, "%s at %.1f ms took %.1f ms", name, start / 1000.0, duration / 1000.0);
+        }
+        if (!finished && !fileName.isEmpty()) {
+            events.append({QByteArray(name), start, duration});
+        }
+    }
+
+    /** the time of the first paint, or -1 */
+    qint64 firstPaint = -1;
+
+    void write() const
+    {
+        const qint64 pid = QCoreApplication::applicationPid();
+        QJsonArray traceEvents;
+        for (const TraceEvent &event : events) {
+            QJsonObject object{
+                {QStringLiteral("name"), QString::fromUtf8(event.name)},
+                {QStringLiteral("ts"), event.start},
+                {QStringLiteral("pid"), pid},
+                {QStringLiteral("tid"), 1},
+            };
+            if (event.duration < 0) {
+                object.insert(QStringLiteral("ph"), QStringLiteral("i"));
+                object.insert(QStringLiteral("s"), QStringLiteral("p"));
+            } else {
+                object.insert(QStringLiteral("ph"), QStringLiteral("X"));
+                object.insert(QStringLiteral("dur"), event.duration);
+            }
+            traceEvents.append(object);
+        }
+
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCWarning(KORGANIZER_STARTUP_LOG) << "Cannot write the startup trace" << fileName << file.errorString();
+            return;
+        }
+        const QJsonObject root{
+            {QStringLiteral("traceEvents"), traceEvents},
+            {QStringLiteral("displayTimeUnit"), QStringLiteral("ms")},
+        };
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    }
+
+    QElapsedTimer timer;
+    const QString fileName;
+    QList<TraceEvent> events;
+    bool finishing = false;
+    bool finished = false;
+};
+
+Trace &trace()
+{
+    static Trace s_trace;
+    return s_trace;
+}
+
+/**
+  Waits for the first expose of the window of a widget. The window paints
+  while handling the expose event, so the function is queued behind it.
+*/
+class FirstPaintWatcher : public QObject
+{
+public:
+    FirstPaintWatcher(QWidget *widget, const std::function<void()> &function)
+        : QObject(widget)
+        , mWidget(widget)
+        , mFunction(function)
+    {
+        if (widget->isVisible()) {
+            watchWindow();
+        } else {
+            widget->installEventFilter(this);
+        }
+        QTimer::singleShot(firstPaintTimeout, this, &FirstPaintWatcher::run);
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (watched == mWidget && event->type() == QEvent::Show) {
+            mWidget->removeEventFilter(this);
+            watchWindow();
+        } else if (watched == mWindow && event->type() == QEvent::Expose && mWindow->isExposed()) {
+            mWindow->removeEventFilter(this);
+            run();
+        }
+        return false;
+    }
+
+private:
+    void watchWindow()
+    {
+        mWindow = mWidget->window()->windowHandle();
+        if (!mWindow || mWindow->isExposed()) {
+            run();
+        } else {
+            mWindow->installEventFilter(this);
+        }
+    }
+
+    void run()
+    {
+        if (mScheduled) {
+            return;
+        }
+        mScheduled = true;
+        Trace &t = trace();
+        if (t.firstPaint < 0 && mWindow && mWindow->isExposed()) {
+            t.firstPaint = t.now();
+        }
+        QTimer::singleShot(0, this, [this]() {
+            mFunction();
+            deleteLater();
+        });
+    }
+
+    QWidget *const mWidget;
+    QPointer<QWindow> mWindow;
+    const std::function<void()> mFunction;
+    bool mScheduled = false;
+};
+}
+
+StartupTrace::Phase::Phase(const char *name)
+    : mName(name)
+    , mStart(trace().now())
+{
+}
+
+StartupTrace::Phase::~Phase()
+{
+    Trace &t = trace();
+    t.record(mName, mStart, t.now() - mStart);
+}
+
+void StartupTrace::mark(const char *name)
+{
+    Trace &t = trace();
+    t.record(name, t.now(), -1);
+}
+
+void StartupTrace::afterFirstPaint(QWidget *widget, const std::function<void()> &function)
+{
+    new FirstPaintWatcher(widget, function);
+}
+
+void StartupTrace::finish()
+{
+    Trace &t = trace();
+    if (t.finishing) {
+        return;
+    }
+    t.finishing = true;
+    QTimer::singleShot(0, qApp, []() {
+        mark("startup finished");
+        Trace &t = trace();
+        // The number to compare between versions, also without a trace file
+        if (t.firstPaint >= 0) {
+            qCInfo(KORGANIZER_STARTUP_LOG, "First paint after %.1f ms", t.firstPaint / 1000.0);
+        }
+        if (!t.fileName.isEmpty()) {
+            t.write();
+        }
+        t.finished = true;
+        t.events.clear();
+    });
+}
@@ -0,0 +1,74 @@
+/*
+  This file is part of KOrganizer.
+
+  SPDX-FileCopyrightText: 2026 KOrganizer developers
+
+  SPDX-License-Identifier: GPL-2.0-or-later WITH LicenseRef-Qt-Commercial-exception-1.0
+*/
+
+#pragma once
+
+#include "korganizerprivate_export.h"
+
+#include <QtGlobal>
+
+#include <functional>
+
+class QWidget;
+
+namespace KOrg
+{
+/**
+  Records the phases of the startup of KOrganizer.
+
+  Each phase is logged with its offset from the start of the trace and its
+  duration to the org.kde.pim.korganizer.startup category. When the
+  environment variable KORGANIZER_STARTUP_TRACE names a file, the phases
+  are also written there in the Chrome trace event format once the
+  startup finished, for chrome://tracing or Perfetto.
+
+  Work which is not needed to show the first frame is registered with
+  afterFirstPaint() instead of running in the constructors.
+
+  @short Startup tracing
+*/
+class KORGANIZERPRIVATE_EXPORT StartupTrace
+{
+public:
+    /**
+      Measures the phase @p name from construction to destruction.
+      Phases may nest.
+    */
+    class KORGANIZERPRIVATE_EXPORT Phase
+    {
+    public:
+        explicit Phase(const char *name);
+        ~Phase();
+
+    private:
+        Q_DISABLE_COPY(Phase)
+
+        const char *const mName;
+        const qint64 mStart;
+    };
+
+    /**
+      Records the instant @p name. The first call starts the trace.
+    */
+    static void mark(const char *name);
+
+    /**
+      Calls @p function once the window showing @p widget was painted for
+      the first time, or soon if it already was. If the window is not shown
+      within a few seconds, @p function is called anyway. Nothing is called
+      if @p widget is deleted before.
+    */
+    static void afterFirstPaint(QWidget *widget, const std::function<void()> &function);
+
+    /**
+      Ends the trace once the events already queued were processed, and
+      writes the trace file. Later phases are only logged.
+    */
+    static void finish();
+};
+}
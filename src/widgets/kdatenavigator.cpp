@@ -86,14 +86,9 @@ KDateNavigator::KDateNavigator(QWidget *parent)
 
 KDateNavigator::~KDateNavigator() = default;
 
-void KDateNavigator::addCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
+void KDateNavigator::setDayOccupancy(DayOccupancy *occupancy)
 {
-    mDayMatrix->addCalendar(calendar);
-}
-
-void KDateNavigator::removeCalendar(const Akonadi::CollectionCalendar::Ptr &calendar)
-{
-    mDayMatrix->removeCalendar(calendar);
+    mDayMatrix->setDayOccupancy(occupancy);
 }
 
 void KDateNavigator::setBaseDate(const QDate &date)
@@ -121,8 +116,8 @@ QSizePolicy KDateNavigator::navBarSizePolicy() const
 
 void KDateNavigator::updateToday()
 {
+    // repaints the old and the new today only
     mDayMatrix->recalculateToday();
-    mDayMatrix->update();
 }
 
 QDate KDateNavigator::startDate() const
@@ -152,11 +147,6 @@ QDate KDateNavigator::endDate() const
     return startDate().addDays(6 * 7);
 }
 
-void KDateNavigator::setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals) const
-{
-    mDayMatrix->setHighlightMode(highlightEvents, highlightTodos, highlightJournals);
-}
-
 void KDateNavigator::updateDates()
 {
     QDate const dayone = startDate();
@@ -10,7 +10,6 @@
 
 #pragma once
 
-#include <Akonadi/CollectionCalendar>
 #include <KCalendarCore/IncidenceBase> //for DateList typedef
 #include <QDate>
 #include <QFrame>
@@ -23,6 +22,7 @@ namespace Akonadi
 class Item;
 }
 
+class DayOccupancy;
 class QLabel;
 
 class KDateNavigator : public QFrame
@@ -32,8 +32,7 @@ public:
     explicit KDateNavigator(QWidget *parent = nullptr);
     ~KDateNavigator() override;
 
-    void addCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
-    void removeCalendar(const Akonadi::CollectionCalendar::Ptr &calendar);
+    void setDayOccupancy(DayOccupancy *occupancy);
 
     void setBaseDate(const QDate &);
 
@@ -51,7 +50,6 @@ public:
 
     [[nodiscard]] QDate startDate() const;
     [[nodiscard]] QDate endDate() const;
-    void setHighlightMode(bool highlightEvents, bool highlightTodos, bool highlightJournals) const;
 
     /**
        Returns the current displayed month.